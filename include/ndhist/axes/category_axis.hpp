@@ -0,0 +1,642 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * @brief This file defines the CategoryAxis class for a histogram axis, whose
+ *        bins are discrete categories, identified by integer or string labels.
+ *        Bin i spans the index range [i, i+1). A growable category axis
+ *        appends unknown categories at its back through the axis extension
+ *        machinery.
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_AXES_CATEGORY_AXIS_HPP_INCLUDED
+#define NDHIST_AXES_CATEGORY_AXIS_HPP_INCLUDED 1
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/python.hpp>
+
+#include <boost/numpy/ndarray.hpp>
+#include <boost/numpy/iterators/value_type_traits.hpp>
+#include <boost/numpy/iterators/flat_iterator.hpp>
+
+#include <ndhist/axis.hpp>
+#include <ndhist/error.hpp>
+#include <ndhist/limits.hpp>
+#include <ndhist/detail/flat_hash_map.hpp>
+
+namespace bp = boost::python;
+namespace bn = boost::numpy;
+
+namespace ndhist {
+namespace axes {
+
+/**
+ * The CategoryAxis class provides an axis with one bin per category. The
+ * categories are either 64-bit integers (int64 axis values) or strings (object
+ * axis values). Integer categories, whose value span is not larger than
+ * NDHIST_LIMIT_CATEGORY_AXIS_DENSE_SPAN_FACTOR times the number of categories,
+ * are looked up through a dense offset table. Sparser integer categories and
+ * string categories are looked up through a flat hash map.
+ *
+ * A non-extendable category axis can have an overflow bin, that collects all
+ * values, which are not a category of the axis. An extendable (growable)
+ * category axis adds unknown categories as new bins at its back instead.
+ */
+class CategoryAxis
+  : public Axis
+{
+  public:
+    typedef Axis
+            base;
+
+    typedef CategoryAxis
+            type;
+
+  public:
+    /**
+     * @brief Constructs a category axis. An extendable category axis adds
+     *     unknown categories as new bins, so it never has an overflow bin,
+     *     regardless of the given has_overflow_bin flag.
+     */
+    CategoryAxis(
+        bn::ndarray const & categories
+      , std::string const & label
+      , std::string const & name
+      , bool has_overflow_bin
+      , bool is_extendable
+      , intptr_t extension_max_bcap
+    )
+      : Axis(
+            categories.get_size() + (has_overflow_bin && !is_extendable)
+          , categories.get_dtype()
+          , label
+          , name
+          , false // has_underflow_bin
+          , has_overflow_bin && !is_extendable
+          , is_extendable
+          , 0     // extension_max_fcap
+          , extension_max_bcap
+        )
+      , is_string_(false)
+      , n_categories_(0)
+      , is_dense_(false)
+      , dense_min_(0)
+    {
+        init(categories);
+    }
+
+    /**
+     * Copy constructor.
+     */
+    CategoryAxis(CategoryAxis const & other)
+      : Axis(other)
+      , is_string_(static_cast<type const &>(other.get_axis_base()).is_string_)
+      , n_categories_(static_cast<type const &>(other.get_axis_base()).n_categories_)
+      , int_categories_(static_cast<type const &>(other.get_axis_base()).int_categories_)
+      , str_categories_(static_cast<type const &>(other.get_axis_base()).str_categories_)
+      , is_dense_(static_cast<type const &>(other.get_axis_base()).is_dense_)
+      , dense_min_(static_cast<type const &>(other.get_axis_base()).dense_min_)
+      , dense_table_(static_cast<type const &>(other.get_axis_base()).dense_table_)
+      , int_map_(static_cast<type const &>(other.get_axis_base()).int_map_)
+      , str_map_(static_cast<type const &>(other.get_axis_base()).str_map_)
+    {}
+
+    inline
+    void
+    init(bn::ndarray const & categories)
+    {
+        // Set up the axis's function pointers.
+        create_fct_                     = &type::create;
+        get_bin_index_fct_              = &type::get_bin_index;
+        get_binedges_ndarray_fct_       = &type::get_binedges_ndarray;
+        get_lower_binedges_ndarray_fct_ = &type::get_lower_binedges_ndarray;
+        get_upper_binedges_ndarray_fct_ = &type::get_upper_binedges_ndarray;
+        get_bincenters_ndarray_fct_     = &type::get_bincenters_ndarray;
+        get_binwidths_ndarray_fct_      = &type::get_binwidths_ndarray;
+        get_n_bins_fct_                 = &type::get_n_bins;
+        request_extension_fct_          = &type::request_extension;
+        extend_fct_                     = &type::extend;
+        create_axis_slice_fct_          = &type::create_axis_slice;
+        deepcopy_fct_                   = &type::deepcopy;
+
+        if(categories.get_nd() != 1)
+        {
+            std::stringstream ss;
+            ss << "The categories array must be 1-dimensional! But it has "
+               << categories.get_nd() << " dimensions!";
+            throw ValueError(ss.str());
+        }
+
+        bn::dtype const dt = categories.get_dtype();
+        if(bn::dtype::equivalent(dt, bn::dtype::get_builtin<int64_t>()))
+        {
+            is_string_ = false;
+            typedef bn::iterators::flat_iterator< bn::iterators::single_value<int64_t> >
+                    iter_t;
+            iter_t it(categories, bn::detail::iter_operand::flags::READONLY::value);
+            while(! it.is_end())
+            {
+                int_categories_.push_back(*it);
+                ++it;
+            }
+            rebuild_int_lookup();
+            if(intptr_t(int_categories_.size()) != get_n_int_lookup_entries())
+            {
+                std::stringstream ss;
+                ss << "The categories of the category axis \"" << name_ << "\" "
+                   << "must be unique!";
+                throw ValueError(ss.str());
+            }
+        }
+        else if(bn::dtype::equivalent(dt, bn::dtype::get_builtin<bp::object>()))
+        {
+            is_string_ = true;
+            typedef bn::iterators::flat_iterator< bn::iterators::single_value<bp::object> >
+                    iter_t;
+            iter_t it(categories, bn::detail::iter_operand::flags::READONLY::value);
+            while(! it.is_end())
+            {
+                bp::object obj = *it;
+                bp::extract<std::string> str(obj);
+                if(! str.check())
+                {
+                    std::stringstream ss;
+                    ss << "The object categories of the category axis \""
+                       << name_ << "\" must be strings!";
+                    throw TypeError(ss.str());
+                }
+                std::string const s = str();
+                if(str_map_.find(s) != -1)
+                {
+                    std::stringstream ss;
+                    ss << "The categories of the category axis \"" << name_
+                       << "\" must be unique! The category \"" << s << "\" "
+                       << "is given more than once.";
+                    throw ValueError(ss.str());
+                }
+                str_map_.insert(s, str_categories_.size());
+                str_categories_.push_back(s);
+                ++it;
+            }
+        }
+        else
+        {
+            std::stringstream ss;
+            ss << "The categories of a category axis must be given as an int64 "
+               << "array or as an object array of strings!";
+            throw TypeError(ss.str());
+        }
+
+        n_categories_ = (is_string_ ? str_categories_.size() : int_categories_.size());
+    }
+
+    /**
+     * @brief Returns true, if the integer categories are looked up through
+     *     the dense offset table, and false if they are looked up through the
+     *     flat hash map.
+     */
+    inline
+    bool
+    has_dense_lookup() const
+    {
+        return (!is_string_ && is_dense_);
+    }
+
+    /**
+     * @brief Returns a ndarray holding the (committed) categories of this
+     *     axis, i.e. an int64 array for integer categories or an object array
+     *     of str objects for string categories.
+     */
+    bn::ndarray
+    py_get_categories() const
+    {
+        std::vector<intptr_t> indices(n_categories_);
+        for(intptr_t i=0; i<n_categories_; ++i)
+        {
+            indices[i] = i;
+        }
+        return get_categories_ndarray(indices);
+    }
+
+    static
+    boost::shared_ptr<Axis>
+    create(
+        boost::numpy::ndarray const & /*edges*/
+      , std::string const & /*label*/
+      , std::string const & name
+      , bool /*has_underflow_bin*/
+      , bool /*has_overflow_bin*/
+      , bool /*is_extendable*/
+      , intptr_t /*extension_max_fcap*/
+      , intptr_t /*extension_max_bcap*/
+    )
+    {
+        std::stringstream ss;
+        ss << "The category axis \"" << name << "\" cannot be created from "
+           << "bin edges! Thus, its bins cannot be merged.";
+        throw TypeError(ss.str());
+    }
+
+    static
+    intptr_t
+    get_bin_index(Axis const & axisbase, char * value_ptr, axis::out_of_range_t & oor_flag)
+    {
+        type const & axis = *static_cast<type const *>(&axisbase);
+
+        intptr_t const idx = axis.find_category(value_ptr);
+        if(idx >= 0 && idx < axis.n_categories_)
+        {
+            oor_flag = axis::OOR_NONE;
+            return idx;
+        }
+        if(axis.has_overflow_bin_)
+        {
+            // The value is not a category of this axis, so it goes into the
+            // overflow bin.
+            oor_flag = axis::OOR_NONE;
+            return axis.n_categories_;
+        }
+        oor_flag = axis::OOR_OVERFLOW;
+        return -1;
+    }
+
+    // Determines the number of extra bins needed at the back of the axis in
+    // order to hold the category of the given value. Unknown categories are
+    // appended as pending categories, so subsequent requests for the same
+    // category (before the axis got extended) get the same bin.
+    static
+    intptr_t
+    request_extension(Axis const & axisbase, char * value_ptr, axis::out_of_range_t const /*oor_flag*/)
+    {
+        type & axis = *static_cast<type *>(const_cast<Axis *>( &axisbase ));
+
+        intptr_t idx = axis.find_category(value_ptr);
+        if(idx < 0)
+        {
+            idx = axis.add_pending_category(value_ptr);
+        }
+        return idx - axis.n_categories_ + 1;
+    }
+
+    static
+    void
+    extend(Axis & axisbase, intptr_t f_n_extra_bins, intptr_t b_n_extra_bins)
+    {
+        type & axis = *static_cast<type *>(&axisbase);
+
+        if(f_n_extra_bins > 0)
+        {
+            std::stringstream ss;
+            ss << "A category axis can only be extended at its back!";
+            throw AssertionError(ss.str());
+        }
+        if(b_n_extra_bins > 0)
+        {
+            axis.n_categories_ += b_n_extra_bins;
+        }
+    }
+
+    static
+    intptr_t
+    get_n_bins(Axis const & axisbase)
+    {
+        type const & axis = *static_cast<type const *>(&axisbase);
+        return axis.n_categories_ + axis.has_overflow_bin_;
+    }
+
+    static
+    bn::ndarray
+    get_binedges_ndarray(Axis const & axisbase)
+    {
+        return make_index_ndarray(get_n_bins(axisbase)+1, 0);
+    }
+
+    static
+    bn::ndarray
+    get_lower_binedges_ndarray(Axis const & axisbase)
+    {
+        return make_index_ndarray(get_n_bins(axisbase), 0);
+    }
+
+    static
+    bn::ndarray
+    get_upper_binedges_ndarray(Axis const & axisbase)
+    {
+        return make_index_ndarray(get_n_bins(axisbase), 1);
+    }
+
+    static
+    bn::ndarray
+    get_bincenters_ndarray(Axis const & axisbase)
+    {
+        intptr_t const nbins = get_n_bins(axisbase);
+        std::vector<intptr_t> const shape(1, nbins);
+        bn::ndarray arr = bn::empty(shape, bn::dtype::get_builtin<double>());
+        double * data = reinterpret_cast<double *>(arr.get_data());
+        for(intptr_t i=0; i<nbins; ++i)
+        {
+            data[i] = i + 0.5;
+        }
+        return arr;
+    }
+
+    static
+    bn::ndarray
+    get_binwidths_ndarray(Axis const & axisbase)
+    {
+        intptr_t const nbins = get_n_bins(axisbase);
+        std::vector<intptr_t> const shape(1, nbins);
+        bn::ndarray arr = bn::empty(shape, bn::dtype::get_builtin<double>());
+        std::fill_n(reinterpret_cast<double *>(arr.get_data()), nbins, 1.0);
+        return arr;
+    }
+
+    static
+    boost::shared_ptr<Axis>
+    create_axis_slice(Axis const & axisbase, intptr_t const start, intptr_t const /*stop*/, intptr_t const step, intptr_t const nbins)
+    {
+        type const & axis = *static_cast<type const *>(&axisbase);
+
+        // Select the categories of the sliced bins. The overflow bin (if
+        // selected) is not a category.
+        std::vector<intptr_t> indices;
+        indices.reserve(nbins);
+        bool has_overflow_bin = false;
+        for(intptr_t k=0; k<nbins; ++k)
+        {
+            intptr_t const idx = start + k*step;
+            if(idx == axis.n_categories_)
+            {
+                has_overflow_bin = true;
+            }
+            else
+            {
+                indices.push_back(idx);
+            }
+        }
+
+        // Since the sliced axis defines a data view, it cannot be extended.
+        return boost::shared_ptr<Axis>(new type(
+            axis.get_categories_ndarray(indices)
+          , axis.label_
+          , axis.name_
+          , has_overflow_bin
+          , /*is_extendable=*/false
+          , /*extension_max_bcap=*/0
+        ));
+    }
+
+    NDHIST_AXIS_STATIC_METHOD_DEEPCOPY()
+
+  protected:
+    static
+    bn::ndarray
+    make_index_ndarray(intptr_t const n, intptr_t const offset)
+    {
+        std::vector<intptr_t> const shape(1, n);
+        bn::ndarray arr = bn::empty(shape, bn::dtype::get_builtin<intptr_t>());
+        intptr_t * data = reinterpret_cast<intptr_t *>(arr.get_data());
+        for(intptr_t i=0; i<n; ++i)
+        {
+            data[i] = i + offset;
+        }
+        return arr;
+    }
+
+    bn::ndarray
+    get_categories_ndarray(std::vector<intptr_t> const & indices) const
+    {
+        std::vector<intptr_t> const shape(1, indices.size());
+        if(is_string_)
+        {
+            bn::ndarray arr = bn::empty(shape, bn::dtype::get_builtin<bp::object>());
+            bn::iterators::flat_iterator< bn::iterators::single_value<bp::object> > it(arr, bn::detail::iter_operand::flags::WRITEONLY::value);
+            for(size_t i=0; i<indices.size(); ++i)
+            {
+                it.set_value(bp::str(str_categories_[indices[i]]));
+                ++it;
+            }
+            return arr;
+        }
+
+        bn::ndarray arr = bn::empty(shape, bn::dtype::get_builtin<int64_t>());
+        int64_t * data = reinterpret_cast<int64_t *>(arr.get_data());
+        for(size_t i=0; i<indices.size(); ++i)
+        {
+            data[i] = int_categories_[indices[i]];
+        }
+        return arr;
+    }
+
+    /**
+     * @brief Returns the index of the (committed or pending) category of the
+     *     given value, or -1 if the value is not a category of this axis.
+     */
+    inline
+    intptr_t
+    find_category(char * value_ptr) const
+    {
+        if(is_string_)
+        {
+            return str_map_.find(get_string_value(value_ptr));
+        }
+
+        int64_t const value = *reinterpret_cast<int64_t *>(value_ptr);
+        if(is_dense_)
+        {
+            // A single unsigned comparison checks both table boundaries.
+            uint64_t const offset = uint64_t(value) - uint64_t(dense_min_);
+            return (offset < dense_table_.size() ? dense_table_[offset] : -1);
+        }
+        return int_map_.find(value);
+    }
+
+    std::string
+    get_string_value(char * value_ptr) const
+    {
+        PyObject * obj = reinterpret_cast<PyObject*>(*reinterpret_cast<uintptr_t*>(value_ptr));
+        bp::extract<std::string> str(obj);
+        if(! str.check())
+        {
+            std::stringstream ss;
+            ss << "The values for the category axis \"" << name_ << "\" must "
+               << "be strings!";
+            throw TypeError(ss.str());
+        }
+        return str();
+    }
+
+    /**
+     * @brief Appends the category of the given value as pending category,
+     *     which becomes a committed category once the axis gets extended.
+     *     It returns the index of the new category.
+     */
+    intptr_t
+    add_pending_category(char * value_ptr)
+    {
+        if(is_string_)
+        {
+            intptr_t const idx = str_categories_.size();
+            std::string const s = get_string_value(value_ptr);
+            str_map_.insert(s, idx);
+            str_categories_.push_back(s);
+            return idx;
+        }
+
+        intptr_t const idx = int_categories_.size();
+        int64_t const value = *reinterpret_cast<int64_t *>(value_ptr);
+        int_categories_.push_back(value);
+        insert_int_lookup(value, idx);
+        return idx;
+    }
+
+    inline
+    intptr_t
+    get_n_int_lookup_entries() const
+    {
+        if(! is_dense_)
+        {
+            return int_map_.get_size();
+        }
+        return dense_table_.size() - std::count(dense_table_.begin(), dense_table_.end(), intptr_t(-1));
+    }
+
+    /**
+     * @brief Returns true, if the value span [lo, hi] is dense enough for the
+     *     given number of integer categories to use the dense offset table.
+     */
+    static
+    bool
+    is_dense_span(int64_t const lo, int64_t const hi, uint64_t const n)
+    {
+        uint64_t const span_m1 = uint64_t(hi) - uint64_t(lo);
+        return (span_m1 < uint64_t(NDHIST_LIMIT_CATEGORY_AXIS_DENSE_SPAN_FACTOR)*n);
+    }
+
+    void
+    rebuild_int_lookup()
+    {
+        dense_table_.clear();
+        int_map_.clear();
+        if(int_categories_.empty())
+        {
+            is_dense_ = true;
+            dense_min_ = 0;
+            return;
+        }
+
+        int64_t const lo = *std::min_element(int_categories_.begin(), int_categories_.end());
+        int64_t const hi = *std::max_element(int_categories_.begin(), int_categories_.end());
+        is_dense_ = is_dense_span(lo, hi, int_categories_.size());
+        if(is_dense_)
+        {
+            dense_min_ = lo;
+            dense_table_.assign(uint64_t(hi) - uint64_t(lo) + 1, -1);
+            for(size_t i=0; i<int_categories_.size(); ++i)
+            {
+                // Keep the first index of duplicate categories, so the
+                // duplicate check in init detects them.
+                intptr_t & entry = dense_table_[uint64_t(int_categories_[i]) - uint64_t(lo)];
+                if(entry == -1) entry = i;
+            }
+        }
+        else
+        {
+            for(size_t i=0; i<int_categories_.size(); ++i)
+            {
+                if(int_map_.find(int_categories_[i]) == -1)
+                {
+                    int_map_.insert(int_categories_[i], i);
+                }
+            }
+        }
+    }
+
+    void
+    insert_int_lookup(int64_t const value, intptr_t const idx)
+    {
+        if(! is_dense_)
+        {
+            int_map_.insert(value, idx);
+            return;
+        }
+
+        uint64_t const offset = uint64_t(value) - uint64_t(dense_min_);
+        if(offset < dense_table_.size())
+        {
+            dense_table_[offset] = idx;
+            return;
+        }
+
+        // The value lies outside of the dense table. Grow the table if the
+        // categories stay dense enough. The table grows at least by a factor
+        // of two (within the density limit) in the direction of the value, so
+        // the growth is amortized.
+        int64_t const table_max = int64_t(uint64_t(dense_min_) + dense_table_.size() - 1);
+        int64_t const lo = std::min(dense_min_, value);
+        int64_t const hi = std::max(table_max, value);
+        uint64_t const n = int_categories_.size();
+        if(! is_dense_span(lo, hi, n))
+        {
+            // Switch over to the flat hash map.
+            rebuild_int_lookup();
+            return;
+        }
+        uint64_t const max_size = uint64_t(NDHIST_LIMIT_CATEGORY_AXIS_DENSE_SPAN_FACTOR)*n;
+        uint64_t const min_size = uint64_t(hi) - uint64_t(lo) + 1;
+        uint64_t const new_size = std::max(min_size, std::min(uint64_t(2*dense_table_.size()), max_size));
+        uint64_t const n_extra = new_size - dense_table_.size();
+        if(value < dense_min_)
+        {
+            dense_table_.insert(dense_table_.begin(), n_extra, -1);
+            dense_min_ = int64_t(uint64_t(dense_min_) - n_extra);
+        }
+        else
+        {
+            dense_table_.resize(new_size, -1);
+        }
+        dense_table_[uint64_t(value) - uint64_t(dense_min_)] = idx;
+    }
+
+    /** Flag if the categories are strings (true) or integers (false).
+     */
+    bool is_string_;
+
+    /** The number of committed categories. The category vectors might hold
+     *  additional pending categories, that were requested during a fill but
+     *  not yet added through an axis extension.
+     */
+    intptr_t n_categories_;
+
+    std::vector<int64_t> int_categories_;
+    std::vector<std::string> str_categories_;
+
+    /** The dense offset table for integer categories. The table entry at
+     *  (value - dense_min_) holds the index of the category of the value, or
+     *  -1 if the value is not a category.
+     */
+    bool is_dense_;
+    int64_t dense_min_;
+    std::vector<intptr_t> dense_table_;
+
+    ::ndhist::detail::flat_hash_map<int64_t, ::ndhist::detail::int64_hash> int_map_;
+    ::ndhist::detail::flat_hash_map<std::string, ::ndhist::detail::string_hash> str_map_;
+};
+
+}//namespace axes
+}//namespace ndhist
+
+#endif // !NDHIST_AXES_CATEGORY_AXIS_HPP_INCLUDED
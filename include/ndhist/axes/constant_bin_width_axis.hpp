@@ -12,7 +12,9 @@
 #ifndef NDHIST_AXES_CONSTANT_BIN_WIDTH_AXIS_HPP_INCLUDED
 #define NDHIST_AXES_CONSTANT_BIN_WIDTH_AXIS_HPP_INCLUDED 1
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <string>
 #include <sstream>
 
@@ -22,6 +24,7 @@
 
 #include <ndhist/axis.hpp>
 #include <ndhist/error.hpp>
+#include <ndhist/limits.hpp>
 
 namespace bn = boost::numpy;
 
@@ -114,6 +117,7 @@ class ConstantBinWidthAxis
         // Set up the axis's function pointers.
         create_fct_                     = &type::create;
         get_bin_index_fct_              = &type::get_bin_index;
+        get_bin_indices_fct_            = &type::get_bin_indices;
         get_binedges_ndarray_fct_       = &type::get_binedges_ndarray;
         get_lower_binedges_ndarray_fct_ = &base::get_lower_binedges_ndarray<type>;
         get_upper_binedges_ndarray_fct_ = &base::get_upper_binedges_ndarray<type>;
@@ -139,7 +143,7 @@ class ConstantBinWidthAxis
             throw ValueError(ss.str());
         }
 
-        bn::iterators::flat_iterator< axis_value_type_traits > edges_iter(edges);
+        bn::iterators::flat_iterator< axis_value_type_traits > edges_iter(edges, bn::detail::iter_operand::flags::READONLY::value);
 
         // Set and skip the underflow edge.
         if(has_underflow_bin_)
@@ -268,6 +272,73 @@ class ConstantBinWidthAxis
         axis_value_type const value = value_transform_type::transform(value_cref);
         //std::cout << "Got value = "<<value<<std::endl;
 
+        return get_bin_index_of_transformed_value(axis, value, oor_flag);
+    }
+
+    /**
+     * @brief Gets the bin indices of n values at once. The i-th value is
+     *     located at the address values_ptr + i*values_stride. The bin index
+     *     and the out-of-range flag of each value is written into the given
+     *     indices and oor_flags arrays, respectively.
+     *     The values are transformed by the batched (and possibly approximate)
+     *     transform of the value transform. Values, whose approximate
+     *     transformed value lies within the approximation tolerance of a bin
+     *     edge, are binned again through the exact scalar path, so the
+     *     results are identical to the results of get_bin_index.
+     */
+    static
+    void
+    get_bin_indices(
+        Axis const & axisbase
+      , char * values_ptr
+      , intptr_t const values_stride
+      , intptr_t const n
+      , intptr_t * indices
+      , axis::out_of_range_t * oor_flags
+    )
+    {
+        type const & axis = *static_cast<type const *>(&axisbase);
+
+        axis_value_type const eps = std::numeric_limits<axis_value_type>::epsilon();
+        axis_value_type const abs_bin_width = std::abs(axis.bin_width_);
+        axis_value_type tvalues[NDHIST_LIMIT_FILL_BIN_SEARCH_CHUNK_SIZE];
+        for(intptr_t i0=0; i0<n; i0 += NDHIST_LIMIT_FILL_BIN_SEARCH_CHUNK_SIZE)
+        {
+            intptr_t const m = std::min(n - i0, intptr_t(NDHIST_LIMIT_FILL_BIN_SEARCH_CHUNK_SIZE));
+            char * const chunk_values_ptr = values_ptr + i0*values_stride;
+            value_transform_type::transform_n(chunk_values_ptr, values_stride, m, tvalues);
+            for(intptr_t i=0; i<m; ++i)
+            {
+                axis_value_type const tvalue = tvalues[i];
+                if(! value_transform_type::is_exact)
+                {
+                    // Check if the approximate transformed value could end up
+                    // in a different bin than the exact transformed value. If
+                    // so, fix it up by using the exact scalar path.
+                    char * const value_ptr = chunk_values_ptr + i*values_stride;
+                    axis_value_type const tol = value_transform_type::approx_tolerance(tvalue);
+                    axis_value_type const u = (tvalue - axis.min_)/axis.bin_width_;
+                    axis_value_type const d = u - std::floor(u);
+                    if(   ! value_transform_type::is_approx_valid(*reinterpret_cast<axis_value_type *>(value_ptr))
+                       || std::min(d, 1 - d)*abs_bin_width <= tol + 4*eps*(1 + std::abs(u))*abs_bin_width
+                       || (axis.has_underflow_bin_ && std::abs(tvalue - axis.underflow_edge_) <= tol)
+                       || (axis.has_overflow_bin_  && std::abs(tvalue - axis.overflow_edge_)  <= tol)
+                      )
+                    {
+                        indices[i0 + i] = get_bin_index(axisbase, value_ptr, oor_flags[i0 + i]);
+                        continue;
+                    }
+                }
+                indices[i0 + i] = get_bin_index_of_transformed_value(axis, tvalue, oor_flags[i0 + i]);
+            }
+        }
+    }
+
+  protected:
+    static
+    intptr_t
+    get_bin_index_of_transformed_value(type const & axis, axis_value_type const value, axis::out_of_range_t & oor_flag)
+    {
         if(axis.has_underflow_bin_)
         {
             if(value < axis.underflow_edge_)
@@ -294,8 +365,16 @@ class ConstantBinWidthAxis
             }
         }
 
-        // The value is >= min_.
-        intptr_t const idx = (value - axis.min_)/axis.bin_width_;
+        // The value is >= min_ (or NaN). Values far beyond the axis range,
+        // i.e. +inf and NaN values (e.g. the log10 of a negative value) as
+        // well, must not be converted into an integer bin index.
+        axis_value_type const u = (value - axis.min_)/axis.bin_width_;
+        if(!(u < axis.n_bins_))
+        {
+            oor_flag = axis::OOR_OVERFLOW;
+            return -1;
+        }
+        intptr_t const idx = u;
 
         if(axis.has_overflow_bin_)
         {
@@ -332,6 +411,7 @@ class ConstantBinWidthAxis
         }
     }
 
+  public:
     // Determines the number of extra bins needed to the left (negative number
     // returned) or to the right (positive number returned) of the current axis
     // range.
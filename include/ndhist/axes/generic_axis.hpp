@@ -16,11 +16,17 @@
 #ifndef NDHIST_AXES_GENERIC_AXIS_HPP_INCLUDED
 #define NDHIST_AXES_GENERIC_AXIS_HPP_INCLUDED 1
 
+#include <stdint.h>
+
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/python.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <boost/numpy/ndarray.hpp>
 #include <boost/numpy/iterators/value_type_traits.hpp>
@@ -30,6 +36,7 @@
 #include <ndhist/detail/ndarray_storage.hpp>
 #include <ndhist/ndhist.hpp>
 #include <ndhist/error.hpp>
+#include <ndhist/limits.hpp>
 
 namespace bp = boost::python;
 namespace bn = boost::numpy;
@@ -70,6 +77,253 @@ struct GenericAxisValueCompare<bp::object>
     }
 };
 
+/**
+ * The GenericAxisEdges class holds a plain copy of the POD edge values of a
+ * GenericAxis in sorted and in Eytzinger (breadth-first binary tree) layout,
+ * and provides a branchless upper bound search on them. The Eytzinger layout
+ * keeps the first levels of the search tree within a few cache lines. For a
+ * small number of edges a linear counting scan is used instead, which the
+ * compiler can vectorize.
+ *
+ * In addition, a uniform lookup table over the finite edge range is built. Each
+ * slot holds the index of the first candidate edge for the values of the slot,
+ * so a lookup is one multiplication, one table load, and a few comparisons.
+ * Slots with too many edges fall back to the Eytzinger search.
+ */
+template <typename AxisValueType>
+class GenericAxisEdges
+{
+  public:
+    /** The maximal number of edges for which the linear scan is used.
+     */
+    static intptr_t const LINEAR_SCAN_MAX_N_EDGES = 16;
+
+    /** The maximal number of edges within a lookup table slot, for which the
+     *  lookup table is used.
+     */
+    static intptr_t const LUT_MAX_N_EDGES_PER_SLOT = 4;
+
+    GenericAxisEdges()
+      : n_edges_(0)
+      , lut_size_(0)
+      , lut_min_(0)
+      , lut_max_(0)
+      , lut_inv_width_(0)
+    {}
+
+    void
+    init(bn::ndarray const & edges, intptr_t const lut_size = NDHIST_LIMIT_GENERIC_AXIS_LUT_SIZE)
+    {
+        n_edges_ = edges.get_size();
+        sorted_.resize(n_edges_);
+        bn::iterators::flat_iterator< bn::iterators::single_value<AxisValueType> > edges_iter(edges, bn::detail::iter_operand::flags::READONLY::value);
+        for(intptr_t i=0; i<n_edges_; ++i, ++edges_iter)
+        {
+            sorted_[i] = *edges_iter;
+        }
+
+        // The Eytzinger layout is 1-based, i.e. the element 0 is unused.
+        eytzinger_.resize(n_edges_ + 1);
+        eytzinger_idx_.assign(n_edges_ + 1, n_edges_);
+        intptr_t sorted_idx = 0;
+        fill_eytzinger(sorted_idx, 1);
+
+        build_lut(lut_size);
+    }
+
+    /**
+     * @brief Returns the index of the first edge that is greater than the
+     *     given value, i.e. the same as std::upper_bound. If there is no such
+     *     edge (or the value is NaN), the number of edges is returned.
+     */
+    inline
+    intptr_t
+    upper_bound(AxisValueType const & value) const
+    {
+        if(n_edges_ <= LINEAR_SCAN_MAX_N_EDGES)
+        {
+            // Count the edges that are not greater than the value.
+            intptr_t count = 0;
+            AxisValueType const * const edges = &sorted_[0];
+            for(intptr_t i=0; i<n_edges_; ++i)
+            {
+                count += !(value < edges[i]);
+            }
+            return count;
+        }
+
+        // Use the lookup table for values within its range. NaN values fail
+        // the range check.
+        if(lut_size_ > 0)
+        {
+            double const x = value;
+            if(x >= lut_min_ && x < lut_max_)
+            {
+                intptr_t slot = intptr_t((x - lut_min_) * lut_inv_width_);
+                if(slot >= lut_size_) slot = lut_size_ - 1;
+                intptr_t idx = lut_[slot];
+                if(intptr_t(lut_[slot+1]) - idx <= LUT_MAX_N_EDGES_PER_SLOT)
+                {
+                    // The slot calculation can be off by one slot due to
+                    // rounding, so correct the index in both directions.
+                    while(idx > 0 && value < sorted_[idx-1])
+                    {
+                        --idx;
+                    }
+                    while(idx < n_edges_ && !(value < sorted_[idx]))
+                    {
+                        ++idx;
+                    }
+                    return idx;
+                }
+            }
+        }
+
+        // Descend the Eytzinger tree without branches: go right if the node
+        // is not greater than the value, otherwise go left.
+        AxisValueType const * const eytzinger = &eytzinger_[0];
+        uintptr_t k = 1;
+        while(k <= uintptr_t(n_edges_))
+        {
+            k = 2*k + !(value < eytzinger[k]);
+        }
+        // The result node is the last node where we went left. So strip the
+        // trailing right turns (1 bits) and the final left turn.
+#if defined(__GNUC__)
+        k >>= __builtin_ffsl(~k);
+#else
+        while(k & 1)
+        {
+            k >>= 1;
+        }
+        k >>= 1;
+#endif
+        return eytzinger_idx_[k];
+    }
+
+    inline
+    intptr_t
+    get_n_edges() const
+    {
+        return n_edges_;
+    }
+
+    /**
+     * @brief (Re-)builds the uniform lookup table with the given number of
+     *     slots. A size of 0 disables the lookup table.
+     */
+    void
+    build_lut(intptr_t const lut_size)
+    {
+        lut_size_ = 0;
+        lut_.clear();
+        if(lut_size <= 0 || n_edges_ <= LINEAR_SCAN_MAX_N_EDGES)
+        {
+            return;
+        }
+
+        // Determine the range of the finite edges. Usually only the first
+        // and the last edges are infinite (for the under- and overflow bins).
+        double const max_value = std::numeric_limits<double>::max();
+        intptr_t first = 0;
+        while(first < n_edges_ && !(std::abs(double(sorted_[first])) <= max_value))
+        {
+            ++first;
+        }
+        intptr_t last = n_edges_ - 1;
+        while(last > first && !(std::abs(double(sorted_[last])) <= max_value))
+        {
+            --last;
+        }
+        if(last <= first)
+        {
+            return;
+        }
+        lut_min_ = sorted_[first];
+        lut_max_ = sorted_[last];
+        double const width = (lut_max_ - lut_min_) / lut_size;
+        if(!(width > 0))
+        {
+            return;
+        }
+        lut_inv_width_ = 1. / width;
+
+        // Each slot holds the upper bound index of its lower boundary value,
+        // and the additional last element the one of lut_max_.
+        lut_.resize(lut_size + 1);
+        AxisValueType const * const begin = &sorted_[0];
+        AxisValueType const * const end = begin + n_edges_;
+        for(intptr_t slot=0; slot<lut_size; ++slot)
+        {
+            AxisValueType const boundary = AxisValueType(lut_min_ + slot*width);
+            lut_[slot] = uint32_t(std::upper_bound(begin, end, boundary) - begin);
+        }
+        lut_[lut_size] = uint32_t(std::upper_bound(begin, end, AxisValueType(lut_max_)) - begin);
+        lut_size_ = lut_size;
+    }
+
+  protected:
+    void
+    fill_eytzinger(intptr_t & sorted_idx, uintptr_t k)
+    {
+        if(k <= uintptr_t(n_edges_))
+        {
+            fill_eytzinger(sorted_idx, 2*k);
+            eytzinger_[k] = sorted_[sorted_idx];
+            eytzinger_idx_[k] = sorted_idx;
+            ++sorted_idx;
+            fill_eytzinger(sorted_idx, 2*k + 1);
+        }
+    }
+
+    intptr_t n_edges_;
+    std::vector<AxisValueType> sorted_;
+    std::vector<AxisValueType> eytzinger_;
+    // The sorted index of each Eytzinger element. The element 0 holds the
+    // number of edges, which is the result if no edge is greater than the
+    // value.
+    std::vector<intptr_t> eytzinger_idx_;
+
+    // The uniform lookup table over the range [lut_min_, lut_max_).
+    intptr_t lut_size_;
+    double lut_min_;
+    double lut_max_;
+    double lut_inv_width_;
+    std::vector<uint32_t> lut_;
+};
+
+/**
+ * Object edges are compared through Python, so they are searched with
+ * std::upper_bound directly on the edges array by the GenericAxis class.
+ */
+template <>
+class GenericAxisEdges<bp::object>
+{
+  public:
+    void
+    init(bn::ndarray const &)
+    {}
+
+    intptr_t
+    upper_bound(bp::object const &) const
+    {
+        std::stringstream ss;
+        ss << "The GenericAxisEdges search is not supported for object edges! "
+           << "This is an internal error!";
+        throw AssertionError(ss.str());
+    }
+
+    intptr_t
+    get_n_edges() const
+    {
+        return 0;
+    }
+
+    void
+    build_lut(intptr_t const)
+    {}
+};
+
 }//namespace detail
 
 template <typename AxisValueType>
@@ -95,6 +349,7 @@ class GenericAxis
     bn::iterators::flat_iterator< axis_value_type_traits > edges_arr_iter_;
     bn::iterators::flat_iterator< axis_value_type_traits > edges_arr_iter_end_;
     axis_value_type_traits avtt_;
+    detail::GenericAxisEdges<AxisValueType> edges_search_;
 
   public:
     GenericAxis(
@@ -156,6 +411,7 @@ class GenericAxis
       , edges_arr_((*static_cast<bn::ndarray const *>(&(*static_cast<type const *>(&other.get_axis_base())).edges_arr_)).deepcopy())
       , edges_arr_iter_(bn::iterators::flat_iterator< bn::iterators::single_value<axis_value_type> >(*static_cast<bn::ndarray *>(&edges_arr_), bn::detail::iter_operand::flags::READONLY::value))
       , edges_arr_iter_end_(edges_arr_iter_.end())
+      , edges_search_((*static_cast<type const *>(&other.get_axis_base())).edges_search_)
     {}
 
     inline
@@ -201,6 +457,9 @@ class GenericAxis
         // Initialize a flat iterator over the axis edges.
         edges_arr_iter_ = bn::iterators::flat_iterator< bn::iterators::single_value<axis_value_type> >(arr, bn::detail::iter_operand::flags::READONLY::value);
         edges_arr_iter_end_ = edges_arr_iter_.end();
+
+        // Set up the plain edges copy for the fast search of POD edges.
+        edges_search_.init(arr);
     }
 
     static
@@ -238,17 +497,30 @@ class GenericAxis
 
         // We know that edges is 1-dimensional by construction and the edges are
         // ordered ascedently. Also we know that the value type of the edges is
-        // AxisValueType. So we can use the std::upper_bound binary search for
-        // getting the upper edge for the given value.
-        axis.edges_arr_iter_.reset();
-        bn::iterators::flat_iterator< axis_value_type_traits > ub = std::upper_bound(axis.edges_arr_iter_, axis.edges_arr_iter_end_, value, &detail::GenericAxisValueCompare<axis_value_type>::apply);
-        if(ub == axis.edges_arr_iter_end_)
+        // AxisValueType. So we can use an upper bound binary search for
+        // getting the upper edge for the given value. POD edges are searched
+        // within the plain edges copy, object edges through the edges array
+        // iterator.
+        intptr_t idx;
+        bool is_overflow;
+        if(boost::is_same<axis_value_type, bp::object>::value)
+        {
+            axis.edges_arr_iter_.reset();
+            bn::iterators::flat_iterator< axis_value_type_traits > ub = std::upper_bound(axis.edges_arr_iter_, axis.edges_arr_iter_end_, value, &detail::GenericAxisValueCompare<axis_value_type>::apply);
+            is_overflow = (ub == axis.edges_arr_iter_end_);
+            idx = (is_overflow ? 0 : ub.get_iter_index());
+        }
+        else
+        {
+            idx = axis.edges_search_.upper_bound(value);
+            is_overflow = (idx == axis.edges_search_.get_n_edges());
+        }
+        if(is_overflow)
         {
             // Overflow.
             oor_flag = axis::OOR_OVERFLOW;
             return -1;
         }
-        intptr_t const idx = ub.get_iter_index();
         if(idx == 0)
         {
             // Underflow. ub points to the first element.
@@ -259,6 +531,18 @@ class GenericAxis
         return idx - 1;
     }
 
+    /**
+     * @brief Sets the number of slots of the uniform lookup table, that is
+     *     used to accelerate the bin search for POD edges. A size of 0
+     *     disables the lookup table. The default size is given by the
+     *     NDHIST_LIMIT_GENERIC_AXIS_LUT_SIZE macro.
+     */
+    void
+    set_lut_size(intptr_t const lut_size)
+    {
+        edges_search_.build_lut(lut_size);
+    }
+
     static
     bn::ndarray
     get_binedges_ndarray(Axis const & axisbase)
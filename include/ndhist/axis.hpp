@@ -12,11 +12,13 @@
 #ifndef NDHIST_AXIS_HPP_INCLUDED
 #define NDHIST_AXIS_HPP_INCLUDED 1
 
+#include <stdint.h>
+
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include <boost/preprocessor/seq/for_each.hpp>
-#include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/version.hpp>
 
@@ -45,9 +47,139 @@ enum out_of_range_t
 
 }// namespace axis
 
+namespace detail {
+
+/** The binedges_ops template provides the calculation of the bin centers and
+ *  the bin widths from the bin edges array of an axis with POD axis values
+ *  through plain loops over contiguous memory, which the compiler can
+ *  vectorize.
+ */
+template <typename AxisValueType>
+struct binedges_ops
+{
+    static
+    boost::numpy::ndarray
+    calc_bincenters(boost::numpy::ndarray const & binedges)
+    {
+        boost::numpy::dtype const dt = boost::numpy::dtype::get_builtin<AxisValueType>();
+        boost::numpy::ndarray const edges_arr = boost::numpy::from_object(binedges, dt, 1, 1, boost::numpy::ndarray::CARRAY_RO);
+        intptr_t const n = edges_arr.shape(0) - 1;
+        std::vector<intptr_t> const shape(1, n);
+        boost::numpy::ndarray bincenters = boost::numpy::empty(shape, dt);
+        AxisValueType const * e = reinterpret_cast<AxisValueType const *>(edges_arr.get_data());
+        AxisValueType * c = reinterpret_cast<AxisValueType *>(bincenters.get_data());
+        for(intptr_t i=0; i<n; ++i)
+        {
+            AxisValueType v = e[i] + e[i+1];
+            v *= 0.5;
+            c[i] = v;
+        }
+        return bincenters;
+    }
+
+    static
+    boost::numpy::ndarray
+    calc_binwidths(boost::numpy::ndarray const & binedges)
+    {
+        boost::numpy::dtype const dt = boost::numpy::dtype::get_builtin<AxisValueType>();
+        boost::numpy::ndarray const edges_arr = boost::numpy::from_object(binedges, dt, 1, 1, boost::numpy::ndarray::CARRAY_RO);
+        intptr_t const n = edges_arr.shape(0) - 1;
+        std::vector<intptr_t> const shape(1, n);
+        boost::numpy::ndarray binwidths = boost::numpy::empty(shape, dt);
+        AxisValueType const * e = reinterpret_cast<AxisValueType const *>(edges_arr.get_data());
+        AxisValueType * w = reinterpret_cast<AxisValueType *>(binwidths.get_data());
+        for(intptr_t i=0; i<n; ++i)
+        {
+            w[i] = e[i+1] - e[i];
+        }
+        return binwidths;
+    }
+};
+
+/** For object axis values the bin centers and widths are calculated through
+ *  the Python arithmetic operators of the objects.
+ */
+template <>
+struct binedges_ops<boost::python::object>
+{
+    typedef boost::numpy::iterators::flat_iterator< boost::numpy::iterators::single_value<boost::python::object> >
+            iter_t;
+
+    static
+    boost::numpy::ndarray
+    calc_bincenters(boost::numpy::ndarray const & binedges)
+    {
+        std::vector<intptr_t> const shape(1, binedges.shape(0) - 1);
+        boost::numpy::ndarray bincenters = boost::numpy::empty(shape, boost::numpy::dtype::get_builtin<boost::python::object>());
+        iter_t binedges_it0(binedges, boost::numpy::detail::iter_operand::flags::READONLY::value);
+        iter_t binedges_it1(binedges, boost::numpy::detail::iter_operand::flags::READONLY::value);
+        ++binedges_it1;
+        iter_t bincenters_it(bincenters, boost::numpy::detail::iter_operand::flags::WRITEONLY::value);
+        while(! bincenters_it.is_end())
+        {
+            boost::python::object v = *binedges_it0 + *binedges_it1;
+            v *= 0.5;
+            bincenters_it.set_value(v);
+
+            ++bincenters_it;
+            ++binedges_it0;
+            ++binedges_it1;
+        }
+        return bincenters;
+    }
+
+    static
+    boost::numpy::ndarray
+    calc_binwidths(boost::numpy::ndarray const & binedges)
+    {
+        std::vector<intptr_t> const shape(1, binedges.shape(0) - 1);
+        boost::numpy::ndarray binwidths = boost::numpy::empty(shape, boost::numpy::dtype::get_builtin<boost::python::object>());
+        iter_t binedges_it0(binedges, boost::numpy::detail::iter_operand::flags::READONLY::value);
+        iter_t binedges_it1(binedges, boost::numpy::detail::iter_operand::flags::READONLY::value);
+        ++binedges_it1;
+        iter_t binwidths_it(binwidths, boost::numpy::detail::iter_operand::flags::WRITEONLY::value);
+        while(! binwidths_it.is_end())
+        {
+            boost::python::object v = *binedges_it1 - *binedges_it0;
+            binwidths_it.set_value(v);
+
+            ++binwidths_it;
+            ++binedges_it0;
+            ++binedges_it1;
+        }
+        return binwidths;
+    }
+};
+
+}// namespace detail
+
 class Axis
 {
   public:
+    /** The types of the axis's functions. All of them are pointers to static
+     *  functions of the particular axis class, which get the Axis object as
+     *  first argument. So they can be copied as raw pointers and called
+     *  directly without any further indirection.
+     */
+    typedef boost::shared_ptr<Axis> (*create_fct_t)(
+            boost::numpy::ndarray const & // edges
+          , std::string const &           // label
+          , std::string const &           // name
+          , bool                          // has_underflow_bin
+          , bool                          // has_overflow_bin
+          , bool                          // is_extendable
+          , intptr_t                      // extension_max_fcap
+          , intptr_t                      // extension_max_bcap
+        );
+    typedef intptr_t (*get_bin_index_fct_t)(Axis const &, char * const, axis::out_of_range_t &);
+    typedef void (*get_bin_indices_fct_t)(Axis const &, char *, intptr_t const, intptr_t const, intptr_t *, axis::out_of_range_t *);
+    typedef boost::numpy::ndarray (*get_ndarray_fct_t)(Axis const &);
+    typedef intptr_t (*get_n_bins_fct_t)(Axis const &);
+    typedef intptr_t (*request_extension_fct_t)(Axis const &, char * const, axis::out_of_range_t const);
+    typedef void (*extend_fct_t)(Axis &, intptr_t const, intptr_t const);
+    typedef boost::shared_ptr<Axis> (*create_axis_slice_fct_t)(Axis const &, intptr_t const, intptr_t const, intptr_t const, intptr_t const);
+    typedef boost::shared_ptr<Axis> (*deepcopy_fct_t)(Axis const &);
+
     Axis()
       : dt_(boost::numpy::dtype::get_builtin<void>())
       , label_(std::string(""))
@@ -57,6 +189,19 @@ class Axis
       , is_extendable_(false)
       , extension_max_fcap_(0)
       , extension_max_bcap_(0)
+      , create_fct_(NULL)
+      , get_bin_index_fct_(NULL)
+      , get_bin_indices_fct_(NULL)
+      , get_binedges_ndarray_fct_(NULL)
+      , get_lower_binedges_ndarray_fct_(NULL)
+      , get_upper_binedges_ndarray_fct_(NULL)
+      , get_bincenters_ndarray_fct_(NULL)
+      , get_binwidths_ndarray_fct_(NULL)
+      , get_n_bins_fct_(NULL)
+      , request_extension_fct_(NULL)
+      , extend_fct_(NULL)
+      , create_axis_slice_fct_(NULL)
+      , deepcopy_fct_(NULL)
     {}
 
     Axis(
@@ -78,6 +223,19 @@ class Axis
       , is_extendable_(is_extendable)
       , extension_max_fcap_(extension_max_fcap)
       , extension_max_bcap_(extension_max_bcap)
+      , create_fct_(NULL)
+      , get_bin_index_fct_(NULL)
+      , get_bin_indices_fct_(&Axis::get_bin_indices_by_value)
+      , get_binedges_ndarray_fct_(NULL)
+      , get_lower_binedges_ndarray_fct_(NULL)
+      , get_upper_binedges_ndarray_fct_(NULL)
+      , get_bincenters_ndarray_fct_(NULL)
+      , get_binwidths_ndarray_fct_(NULL)
+      , get_n_bins_fct_(NULL)
+      , request_extension_fct_(NULL)
+      , extend_fct_(NULL)
+      , create_axis_slice_fct_(NULL)
+      , deepcopy_fct_(NULL)
     {
         size_t const nedges = nbins + 1;
 
@@ -104,8 +262,8 @@ class Axis
      * @note If the given axis is wrapped, the new axis will be a copy of the
      *     wrapped axis.
      *
-     * @internal All the function pointers are pointers to static functions, so
-     *     we can just copy the raw pointers.
+     * @internal All the function pointers are raw pointers to static
+     *     functions, so we can just copy them.
      */
     Axis(Axis const & other)
       : dt_(other.get_axis_base().dt_)
@@ -118,6 +276,7 @@ class Axis
       , extension_max_bcap_(other.get_axis_base().extension_max_bcap_)
       , create_fct_(other.get_axis_base().create_fct_)
       , get_bin_index_fct_(other.get_axis_base().get_bin_index_fct_)
+      , get_bin_indices_fct_(other.get_axis_base().get_bin_indices_fct_)
       , get_binedges_ndarray_fct_(other.get_axis_base().get_binedges_ndarray_fct_)
       , get_lower_binedges_ndarray_fct_(other.get_axis_base().get_lower_binedges_ndarray_fct_)
       , get_upper_binedges_ndarray_fct_(other.get_axis_base().get_upper_binedges_ndarray_fct_)
@@ -211,6 +370,119 @@ class Axis
         return get_axis_base().get_bin_index_fct_(get_axis_base(), value_ptr, oor_flag);
     }
 
+    /** Returns the get_bin_index function of the (possibly wrapped) axis.
+     *  Hot loops can resolve it (together with get_axis_base) once and call
+     *  it directly as ``fct(axis.get_axis_base(), value_ptr, oor_flag)``.
+     */
+    inline
+    get_bin_index_fct_t
+    get_bin_index_fct() const
+    {
+        return get_axis_base().get_bin_index_fct_;
+    }
+
+    /** Returns the batched get_bin_indices function of the (possibly wrapped)
+     *  axis, which might be NULL, if the axis class does not provide one.
+     */
+    inline
+    get_bin_indices_fct_t
+    get_bin_indices_fct() const
+    {
+        return get_axis_base().get_bin_indices_fct_;
+    }
+
+    /** Gets the bin indices of n values at once using the native batched bin
+     *  search of the axis. The i-th value is located at the address
+     *  values_ptr + i*values_stride. The bin index and the out-of-range flag
+     *  of each value is written into the given indices and oor_flags arrays,
+     *  respectively. The bin index of an out-of-range value is -1.
+     */
+    inline
+    void
+    get_bin_indices(
+        char * values_ptr
+      , intptr_t const values_stride
+      , intptr_t const n
+      , intptr_t * indices
+      , axis::out_of_range_t * oor_flags
+    ) const
+    {
+        get_axis_base().get_bin_indices_fct_(get_axis_base(), values_ptr, values_stride, n, indices, oor_flags);
+    }
+
+    /** Gets the bin indices of the given values and writes them into the
+     *  given C-contiguous intp out array, which must have as many elements as
+     *  values. It returns an int8 ndarray (with the shape of the values)
+     *  holding the out-of-range flags of the values, i.e. 0 for values within
+     *  the axis range, -1 for underflow values, and -2 for overflow values.
+     */
+    boost::numpy::ndarray
+    py_get_bin_indices(
+        boost::python::object const & values
+      , boost::numpy::ndarray const & out
+    ) const
+    {
+        boost::numpy::ndarray const values_arr = boost::numpy::from_object(values, get_dtype(), 0, 0, boost::numpy::ndarray::CARRAY_RO);
+        intptr_t const n = values_arr.get_size();
+        if(! boost::numpy::dtype::equivalent(out.get_dtype(), boost::numpy::dtype::get_builtin<intptr_t>()))
+        {
+            std::stringstream ss;
+            ss << "The out array for the bin indices must have the intp data "
+               << "type!";
+            throw TypeError(ss.str());
+        }
+        if(out.get_size() != n)
+        {
+            std::stringstream ss;
+            ss << "The out array for the bin indices must have "<< n <<" "
+               << "elements, but it has "<< out.get_size() <<" elements!";
+            throw ValueError(ss.str());
+        }
+        if((out.get_flags() & boost::numpy::ndarray::CARRAY) != boost::numpy::ndarray::CARRAY)
+        {
+            std::stringstream ss;
+            ss << "The out array for the bin indices must be C-contiguous, "
+               << "aligned, and writeable!";
+            throw ValueError(ss.str());
+        }
+
+        std::vector<axis::out_of_range_t> oor_flags(n, axis::OOR_NONE);
+        if(n > 0)
+        {
+            get_bin_indices(values_arr.get_data(), values_arr.get_dtype().get_itemsize(), n, reinterpret_cast<intptr_t *>(out.get_data()), &oor_flags.front());
+        }
+
+        boost::numpy::ndarray oor_arr = boost::numpy::empty(values_arr.get_shape_vector(), boost::numpy::dtype::get_builtin<int8_t>());
+        int8_t * oor_data = reinterpret_cast<int8_t *>(oor_arr.get_data());
+        for(intptr_t i=0; i<n; ++i)
+        {
+            oor_data[i] = int8_t(oor_flags[i]);
+        }
+        return oor_arr;
+    }
+
+    /** Gets the bin indices of n values by calling the get_bin_index function
+     *  for each value. This is the default batched bin search for axis
+     *  classes, which do not provide a native one.
+     */
+    static
+    void
+    get_bin_indices_by_value(
+        Axis const & axisbase
+      , char * values_ptr
+      , intptr_t const values_stride
+      , intptr_t const n
+      , intptr_t * indices
+      , axis::out_of_range_t * oor_flags
+    )
+    {
+        get_bin_index_fct_t const fct = axisbase.get_bin_index_fct_;
+        for(intptr_t i=0; i<n; ++i, values_ptr += values_stride)
+        {
+            indices[i] = fct(axisbase, values_ptr, oor_flags[i]);
+        }
+    }
+
     inline
     intptr_t
     get_extension_max_fcap() const
@@ -329,35 +601,40 @@ class Axis
     boost::numpy::ndarray
     get_binedges_ndarray() const
     {
-        return get_axis_base().get_binedges_ndarray_fct_(get_axis_base());
+        Axis const & base = get_axis_base();
+        return get_cached_ndarray(base.binedges_cache_, base.get_binedges_ndarray_fct_);
     }
 
     inline
     boost::numpy::ndarray
     get_lower_binedges_ndarray() const
     {
-        return get_axis_base().get_lower_binedges_ndarray_fct_(get_axis_base());
+        Axis const & base = get_axis_base();
+        return get_cached_ndarray(base.lower_binedges_cache_, base.get_lower_binedges_ndarray_fct_);
     }
 
     inline
     boost::numpy::ndarray
     get_upper_binedges_ndarray() const
     {
-        return get_axis_base().get_upper_binedges_ndarray_fct_(get_axis_base());
+        Axis const & base = get_axis_base();
+        return get_cached_ndarray(base.upper_binedges_cache_, base.get_upper_binedges_ndarray_fct_);
     }
 
     inline
     boost::numpy::ndarray
     get_bincenters_ndarray() const
     {
-        return get_axis_base().get_bincenters_ndarray_fct_(get_axis_base());
+        Axis const & base = get_axis_base();
+        return get_cached_ndarray(base.bincenters_cache_, base.get_bincenters_ndarray_fct_);
     }
 
     inline
     boost::numpy::ndarray
     get_binwidths_ndarray() const
     {
-        return get_axis_base().get_binwidths_ndarray_fct_(get_axis_base());
+        Axis const & base = get_axis_base();
+        return get_cached_ndarray(base.binwidths_cache_, base.get_binwidths_ndarray_fct_);
     }
 
     inline
@@ -372,6 +649,25 @@ class Axis
     extend(intptr_t const f_n_extra_bins, intptr_t const b_n_extra_bins)
     {
         get_axis_base().extend_fct_(get_axis_base(), f_n_extra_bins, b_n_extra_bins);
+        if(f_n_extra_bins != 0 || b_n_extra_bins != 0)
+        {
+            get_axis_base().invalidate_ndarray_caches();
+        }
+    }
+
+    /** Drops the cached bin edges, bin centers, and bin widths arrays, so they
+     *  get re-calculated the next time they are requested. This function
+     *  must be called whenever the bins of the axis change.
+     */
+    void
+    invalidate_ndarray_caches()
+    {
+        Axis & base = get_axis_base();
+        base.binedges_cache_       = boost::python::object();
+        base.lower_binedges_cache_ = boost::python::object();
+        base.upper_binedges_cache_ = boost::python::object();
+        base.bincenters_cache_     = boost::python::object();
+        base.binwidths_cache_      = boost::python::object();
     }
 
     inline
@@ -388,26 +684,33 @@ class Axis
         return get_axis_base().deepcopy_fct_(get_axis_base());
     }
 
+    /** Returns a read-only view of the array stored in the given cache slot.
+     *  If the cache slot is empty, the array is calculated through the given
+     *  function first and is marked as read-only before it is stored. So the
+     *  bin arrays of an axis are calculated only once until the axis gets
+     *  extended, and their users cannot alter the cached values.
+     */
+    boost::numpy::ndarray
+    get_cached_ndarray(boost::python::object & cache, get_ndarray_fct_t fct) const
+    {
+        if(cache.is_none())
+        {
+            boost::numpy::ndarray arr = fct(get_axis_base());
+            arr.attr("setflags")(false);
+            cache = arr;
+        }
+        return boost::numpy::from_object(cache.attr("view")());
+    }
+
     template <class AxisType>
     static
     boost::numpy::ndarray
     get_lower_binedges_ndarray(Axis const & axisbase)
     {
+        // The lower bin edges are a view into the (cached) bin edges array.
         boost::numpy::ndarray const binedges = axisbase.get_binedges_ndarray();
-        intptr_t shape[1];
-        shape[0] = binedges.shape(0) - 1;
-        boost::numpy::ndarray lower_binedges = boost::numpy::empty(1, shape, boost::numpy::dtype::get_builtin<typename AxisType::axis_value_type>());
-        typedef boost::numpy::iterators::flat_iterator< boost::numpy::iterators::single_value<typename AxisType::axis_value_type> >
-                iter_t;
-        iter_t binedges_it(binedges);
-        iter_t lower_binedges_it(lower_binedges);
-        for(intptr_t i=0; i<shape[0]; ++i)
-        {
-            lower_binedges_it.set_value(*binedges_it);
-            ++binedges_it;
-            ++lower_binedges_it;
-        }
-        return lower_binedges;
+        boost::python::slice sl(0, binedges.shape(0) - 1);
+        return boost::numpy::from_object(binedges[sl]);
     }
 
     template <class AxisType>
@@ -415,22 +718,10 @@ class Axis
     boost::numpy::ndarray
     get_upper_binedges_ndarray(Axis const & axisbase)
     {
+        // The upper bin edges are a view into the (cached) bin edges array.
         boost::numpy::ndarray const binedges = axisbase.get_binedges_ndarray();
-        intptr_t shape[1];
-        shape[0] = binedges.shape(0) - 1;
-        boost::numpy::ndarray upper_binedges = boost::numpy::empty(1, shape, boost::numpy::dtype::get_builtin<typename AxisType::axis_value_type>());
-        typedef boost::numpy::iterators::flat_iterator< boost::numpy::iterators::single_value<typename AxisType::axis_value_type> >
-                iter_t;
-        iter_t binedges_it(binedges);
-        ++binedges_it;
-        iter_t upper_binedges_it(upper_binedges);
-        for(intptr_t i=0; i<shape[0]; ++i)
-        {
-            upper_binedges_it.set_value(*binedges_it);
-            ++binedges_it;
-            ++upper_binedges_it;
-        }
-        return upper_binedges;
+        boost::python::slice sl(1, binedges.shape(0));
+        return boost::numpy::from_object(binedges[sl]);
     }
 
     template <class AxisType>
@@ -438,27 +729,7 @@ class Axis
     boost::numpy::ndarray
     get_bincenters_ndarray(Axis const & axisbase)
     {
-        boost::numpy::ndarray const binedges = axisbase.get_binedges_ndarray();
-        intptr_t shape[1];
-        shape[0] = binedges.shape(0) - 1;
-        boost::numpy::ndarray bincenters = boost::numpy::empty(1, shape, boost::numpy::dtype::get_builtin<typename AxisType::axis_value_type>());
-        typedef boost::numpy::iterators::flat_iterator< boost::numpy::iterators::single_value<typename AxisType::axis_value_type> >
-                iter_t;
-        iter_t binedges_it0(binedges);
-        iter_t binedges_it1(binedges);
-        ++binedges_it1;
-        iter_t bincenters_it(bincenters);
-        while(! bincenters_it.is_end())
-        {
-            typename AxisType::axis_value_type v = *binedges_it0 + *binedges_it1;
-            v *= 0.5;
-            bincenters_it.set_value(v);
-
-            ++bincenters_it;
-            ++binedges_it0;
-            ++binedges_it1;
-        }
-        return bincenters;
+        return detail::binedges_ops<typename AxisType::axis_value_type>::calc_bincenters(axisbase.get_binedges_ndarray());
     }
 
     template <class AxisType>
@@ -466,26 +737,7 @@ class Axis
     boost::numpy::ndarray
     get_binwidths_ndarray(Axis const & axisbase)
     {
-        boost::numpy::ndarray const binedges = axisbase.get_binedges_ndarray();
-        intptr_t shape[1];
-        shape[0] = binedges.shape(0) - 1;
-        boost::numpy::ndarray binwidths = boost::numpy::empty(1, shape, boost::numpy::dtype::get_builtin<typename AxisType::axis_value_type>());
-        typedef boost::numpy::iterators::flat_iterator< boost::numpy::iterators::single_value<typename AxisType::axis_value_type> >
-                iter_t;
-        iter_t binedges_it0(binedges);
-        iter_t binedges_it1(binedges);
-        ++binedges_it1;
-        iter_t binwidths_it(binwidths);
-        while(! binwidths_it.is_end())
-        {
-            typename AxisType::axis_value_type v = *binedges_it1 - *binedges_it0;
-            binwidths_it.set_value(v);
-
-            ++binwidths_it;
-            ++binedges_it0;
-            ++binedges_it1;
-        }
-        return binwidths;
+        return detail::binedges_ops<typename AxisType::axis_value_type>::calc_binwidths(axisbase.get_binedges_ndarray());
     }
 
     template <class AxisType>
@@ -501,7 +753,7 @@ class Axis
 
 
         boost::numpy::ndarray alledges = axisbase.get_binedges_ndarray();
-        iter_t begin(alledges);
+        iter_t begin(alledges, boost::numpy::detail::iter_operand::flags::READONLY::value);
         iter_t end(begin);
         intptr_t const selfnbins = alledges.get_size()-1;
         std::advance(end, selfnbins);
@@ -620,17 +872,7 @@ class Axis
     /** This function is supposed to create a new Axis object of the most
      *  derived class using the standard Axis constructor.
      */
-    boost::function< boost::shared_ptr<Axis> (
-            boost::numpy::ndarray const & // edges
-          , std::string const &           // label
-          , std::string const &           // name
-          , bool                          // has_underflow_bin
-          , bool                          // has_overflow_bin
-          , bool                          // is_extendable
-          , intptr_t                      // extension_max_fcap
-          , intptr_t                      // extension_max_bcap
-        )
-    > create_fct_;
+    create_fct_t create_fct_;
 
     /** This function is supposed to get the axis's bin index for the given data
      *  value (which is stored in memory at the given address).
@@ -639,49 +881,47 @@ class Axis
      *  out_of_range variable must be set accordingly. In that case the return
      *  value of this function is undefined.
      */
-    boost::function<intptr_t (Axis const &, char * const, axis::out_of_range_t &)>
-        get_bin_index_fct_;
+    get_bin_index_fct_t get_bin_index_fct_;
+
+    /** This function is supposed to get the axis's bin indices and
+     *  out-of-range flags of n values at once (see get_bin_indices).
+     */
+    get_bin_indices_fct_t get_bin_indices_fct_;
 
     /** This function is supposed to return (a copy of) the edges array
      *  (including the possible under- and overflow bins) as a
      *  boost::numpy::ndarray object.
      */
-    boost::function<boost::numpy::ndarray (Axis const &)>
-        get_binedges_ndarray_fct_;
+    get_ndarray_fct_t get_binedges_ndarray_fct_;
 
     /** This function is supposed to return a ndarray holding the lower bin
      *  edge values. The length of this array must be equal to the value that
      *  is returned by the get_n_bins_fct_ function.
      */
-    boost::function<boost::numpy::ndarray (Axis const &)>
-        get_lower_binedges_ndarray_fct_;
+    get_ndarray_fct_t get_lower_binedges_ndarray_fct_;
 
     /** This function is supposed to return a ndarray holding the upper bin
      *  edge values. The length of this array must be equal to the value that
      *  is returned by the get_n_bins_fct_ function.
      */
-    boost::function<boost::numpy::ndarray (Axis const &)>
-        get_upper_binedges_ndarray_fct_;
+    get_ndarray_fct_t get_upper_binedges_ndarray_fct_;
 
     /** This function is supposed to return (a copy of) the bincenters array
      *  (including the possible under- and overflow bins) as a
      *  boost::numpy::ndarray object.
      */
-    boost::function<boost::numpy::ndarray (Axis const &)>
-        get_bincenters_ndarray_fct_;
+    get_ndarray_fct_t get_bincenters_ndarray_fct_;
 
     /** This function is supposed to return (a copy of) the binwidths array
      *  (including the possible under- and overflow bins) as a
      *  boost::numpy::ndarray object.
      */
-    boost::function<boost::numpy::ndarray (Axis const &)>
-        get_binwidths_ndarray_fct_;
+    get_ndarray_fct_t get_binwidths_ndarray_fct_;
 
     /** This function is supposed to return the number of bins of the axis
      *  (including the possible under- and overflow bins).
      */
-    boost::function<intptr_t (Axis const &)>
-        get_n_bins_fct_;
+    get_n_bins_fct_t get_n_bins_fct_;
 
     /** This function is supposed to calculate the number of bins, that would
      *  have to be added to the left (negative returned value) or to the right
@@ -692,16 +932,14 @@ class Axis
      *  Note: This function is only called, when the axis is extendable, thus
      *        there are no under- and overflow bins defined in those cases.
      */
-    boost::function<intptr_t (Axis const &, char * const, axis::out_of_range_t const)>
-        request_extension_fct_;
+    request_extension_fct_t request_extension_fct_;
 
     /** This function is supposed to extend the axis by the given number of bins
      *  to the left and the right of the axis, respectively.
      *  Note: This function is only called, when the axis is extendable, thus
      *        there are no under- and overflow bins defined in those cases.
      */
-    boost::function<void (Axis &, intptr_t const, intptr_t const)>
-        extend_fct_;
+    extend_fct_t extend_fct_;
 
     /**
      * @brief This function is supposed to create an axis of the same type as
@@ -714,15 +952,23 @@ class Axis
      *     Nbins is the number of bins of the resulting axis. Thus, the number
      *     of edges of the resulting axis must be nbins+1.
      */
-    boost::function<boost::shared_ptr<Axis> (Axis const &, intptr_t const, intptr_t const, intptr_t const, intptr_t const)>
-        create_axis_slice_fct_;
+    create_axis_slice_fct_t create_axis_slice_fct_;
 
     /**
      * @brief This function is supposed to create a deep copy of the given
      *     Axis (and it's derived class) object.
      */
-    boost::function<boost::shared_ptr<Axis> (Axis const &)>
-        deepcopy_fct_;
+    deepcopy_fct_t deepcopy_fct_;
+
+    /** The caches of the read-only bin edges, lower and upper bin edges, bin
+     *  centers, and bin widths arrays. An empty cache slot holds None.
+     *  Copies of an axis start with empty caches.
+     */
+    mutable boost::python::object binedges_cache_;
+    mutable boost::python::object lower_binedges_cache_;
+    mutable boost::python::object upper_binedges_cache_;
+    mutable boost::python::object bincenters_cache_;
+    mutable boost::python::object binwidths_cache_;
 };
 
 /** Define static method implemenation to create a new Axis object of the
@@ -865,6 +1111,21 @@ class axis_pyinterface
           , "The ndarray holding the bin width values of the axis "
             "(including possible under- and overflow bins)."
         );
+        cls.def("get_bin_indices"
+          , &Axis::py_get_bin_indices
+          , ( boost::python::arg("self")
+            , boost::python::arg("values")
+            , boost::python::arg("out")
+            )
+          , "Gets the bin indices (including possible under- and overflow "
+            "bins) of the given values using the native bin search of the "
+            "axis and writes them into the given C-contiguous intp ndarray "
+            "``out``, which must have as many elements as ``values``. The bin "
+            "index of an out-of-range value is -1. It returns an int8 ndarray "
+            "holding the out-of-range flags of the values, i.e. 0 for values "
+            "within the axis range, -1 for underflow values, and -2 for "
+            "overflow values."
+        );
     }
 };
 
@@ -0,0 +1,265 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_DETAIL_AXIS_OVERLAP_MATRIX_HPP_INCLUDED
+#define NDHIST_DETAIL_AXIS_OVERLAP_MATRIX_HPP_INCLUDED 1
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <ndhist/error.hpp>
+
+namespace ndhist {
+namespace detail {
+
+/**
+ * The axis_overlap_matrix class describes how the bins of an old axis map onto
+ * the bins of a new axis with different bin edges. It is a sparse matrix in
+ * compressed row format, where the rows are the old bin indices (including
+ * the under- and overflow bins). The entries of the old bin j are stored at
+ * the positions [row_begin_[j], row_begin_[j+1]). Each entry holds the new bin
+ * index and the fraction interval [frac_lo, frac_hi) of the old bin, that goes
+ * into the new bin. The fraction intervals of an old bin are consecutive, so
+ * integer quantities can be split by cumulative rounding without changing
+ * their sum.
+ */
+class axis_overlap_matrix
+{
+  public:
+    /**
+     * @brief Calculates the overlap matrix between the old bins defined by
+     *     the given old bin edges (including the edges of possible under- and
+     *     overflow bins) and the new (visible) bins defined by the given new
+     *     bin edges. Old bins outside of the range of the new bins go into the
+     *     under- or overflow bin of the new axis, which will be created if
+     *     required. Unless split is set to true, the new bin edges must be
+     *     aligned with the old bin edges, i.e. each old bin must lie within
+     *     exactly one new bin. Otherwise, an old bin, that overlaps with several
+     *     new bins, is split proportional to the overlapping lengths.
+     */
+    axis_overlap_matrix(
+        std::vector<double> const & old_edges
+      , bool const old_has_underflow_bin
+      , bool const old_has_overflow_bin
+      , std::vector<double> const & new_edges
+      , bool const split
+    )
+    {
+        intptr_t const old_n_bins = intptr_t(old_edges.size()) - 1;
+        intptr_t const new_n_edges = new_edges.size();
+        if(new_n_edges < 2)
+        {
+            std::stringstream ss;
+            ss << "The new edges array need to have at least 2 elements! But "
+               << "it contains only "<<new_n_edges<<" edge values!";
+            throw ValueError(ss.str());
+        }
+        for(intptr_t k=1; k<new_n_edges; ++k)
+        {
+            if(! (new_edges[k-1] < new_edges[k]))
+            {
+                std::stringstream ss;
+                ss << "The new edges must be strictly ascending!";
+                throw ValueError(ss.str());
+            }
+        }
+
+        intptr_t const old_first = old_has_underflow_bin;
+        intptr_t const old_last  = old_n_bins - old_has_overflow_bin;
+        intptr_t const new_n_bins = new_n_edges - 1;
+        double const new_min = new_edges.front();
+        double const new_max = new_edges.back();
+
+        has_underflow_bin_ = (old_has_underflow_bin || old_edges[old_first] < new_min);
+        has_overflow_bin_  = (old_has_overflow_bin  || old_edges[old_last]  > new_max);
+        if(has_underflow_bin_ && ! (old_edges.front() < new_min))
+        {
+            std::stringstream ss;
+            ss << "The first new edge must be greater than the lower edge of "
+               << "the underflow bin, which is "<<old_edges.front()<<"!";
+            throw ValueError(ss.str());
+        }
+        if(has_overflow_bin_ && ! (old_edges.back() > new_max))
+        {
+            std::stringstream ss;
+            ss << "The last new edge must be smaller than the upper edge of "
+               << "the overflow bin, which is "<<old_edges.back()<<"!";
+            throw ValueError(ss.str());
+        }
+
+        // Set the edges of the new axis.
+        if(has_underflow_bin_)
+        {
+            edges_.push_back(old_edges.front());
+        }
+        edges_.insert(edges_.end(), new_edges.begin(), new_edges.end());
+        if(has_overflow_bin_)
+        {
+            edges_.push_back(old_edges.back());
+        }
+        n_bins_ = edges_.size() - 1;
+
+        intptr_t const new_underflow_idx = 0;
+        intptr_t const new_overflow_idx  = n_bins_ - 1;
+
+        row_begin_.reserve(old_n_bins + 1);
+        if(old_has_underflow_bin)
+        {
+            row_begin_.push_back(new_idx_.size());
+            push_entry(new_underflow_idx, 0, 1);
+        }
+        for(intptr_t j=old_first; j<old_last; ++j)
+        {
+            row_begin_.push_back(new_idx_.size());
+
+            double const a = old_edges[j];
+            double const b = old_edges[j+1];
+            double const width = b - a;
+
+            // Find the new bin containing the lower edge of the old bin. The
+            // index -1 denotes the new underflow bin and new_n_bins the new
+            // overflow bin.
+            intptr_t k = intptr_t(std::upper_bound(new_edges.begin(), new_edges.end(), a) - new_edges.begin()) - 1;
+            double frac = 0;
+            while(true)
+            {
+                double const lo = (k < 0 ? -std::numeric_limits<double>::infinity() : new_edges[k]);
+                double const hi = (k+1 < new_n_edges ? new_edges[k+1] : std::numeric_limits<double>::infinity());
+                double const overlap = std::min(b, hi) - std::max(a, lo);
+                if(overlap > 0)
+                {
+                    intptr_t const idx = (k < 0 ? new_underflow_idx : (k < new_n_bins ? has_underflow_bin_ + k : new_overflow_idx));
+                    double const frac_hi = (hi >= b ? 1. : std::min(1., frac + overlap/width));
+                    push_entry(idx, frac, frac_hi);
+                    frac = frac_hi;
+                }
+                if(hi >= b)
+                {
+                    break;
+                }
+                ++k;
+            }
+
+            if(! split && intptr_t(new_idx_.size()) - row_begin_.back() > 1)
+            {
+                std::stringstream ss;
+                ss << "The old bin ["<<a<<", "<<b<<") overlaps with more than "
+                   << "one new bin! Either align the new edges with the old "
+                   << "edges, or allow the splitting of old bins!";
+                throw ValueError(ss.str());
+            }
+        }
+        if(old_has_overflow_bin)
+        {
+            row_begin_.push_back(new_idx_.size());
+            push_entry(new_overflow_idx, 0, 1);
+        }
+        row_begin_.push_back(new_idx_.size());
+    }
+
+    /** Returns the number of new bins, including the under- and overflow bins.
+     */
+    inline
+    intptr_t
+    get_n_bins() const
+    {
+        return n_bins_;
+    }
+
+    /** Returns the bin edges of the new axis, including the edges of the
+     *  under- and overflow bins.
+     */
+    inline
+    std::vector<double> const &
+    get_edges() const
+    {
+        return edges_;
+    }
+
+    inline
+    bool
+    has_underflow_bin() const
+    {
+        return has_underflow_bin_;
+    }
+
+    inline
+    bool
+    has_overflow_bin() const
+    {
+        return has_overflow_bin_;
+    }
+
+    inline
+    intptr_t
+    get_row_begin(intptr_t const old_idx) const
+    {
+        return row_begin_[old_idx];
+    }
+
+    inline
+    intptr_t
+    get_row_end(intptr_t const old_idx) const
+    {
+        return row_begin_[old_idx+1];
+    }
+
+    inline
+    intptr_t
+    get_new_idx(intptr_t const entry) const
+    {
+        return new_idx_[entry];
+    }
+
+    inline
+    double
+    get_frac_lo(intptr_t const entry) const
+    {
+        return frac_lo_[entry];
+    }
+
+    inline
+    double
+    get_frac_hi(intptr_t const entry) const
+    {
+        return frac_hi_[entry];
+    }
+
+  protected:
+    inline
+    void
+    push_entry(intptr_t const new_idx, double const frac_lo, double const frac_hi)
+    {
+        new_idx_.push_back(new_idx);
+        frac_lo_.push_back(frac_lo);
+        frac_hi_.push_back(frac_hi);
+    }
+
+    bool has_underflow_bin_;
+    bool has_overflow_bin_;
+    intptr_t n_bins_;
+    std::vector<double> edges_;
+
+    std::vector<intptr_t> row_begin_;
+    std::vector<intptr_t> new_idx_;
+    std::vector<double>   frac_lo_;
+    std::vector<double>   frac_hi_;
+};
+
+}// namespace detail
+}// namespace ndhist
+
+#endif // !NDHIST_DETAIL_AXIS_OVERLAP_MATRIX_HPP_INCLUDED
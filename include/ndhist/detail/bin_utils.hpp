@@ -12,11 +12,42 @@
 #ifndef NDHIST_DETAIL_BIN_UTILS_HPP_INCLUDED
 #define NDHIST_DETAIL_BIN_UTILS_HPP_INCLUDED 1
 
+#include <sstream>
+#include <vector>
+
+#include <boost/numpy/dtype.hpp>
+
+#include <ndhist/error.hpp>
 #include <ndhist/detail/bin_value.hpp>
 
 namespace ndhist {
 namespace detail {
 
+/**
+ * The profile_sums_offsets class holds the byte offsets of the sum of the
+ * weighted profile values (sowy) and of the sum of the weighted squared profile
+ * values (sowyy) within a bin of a profile histogram. They are taken from the
+ * fields of the bin content data type.
+ */
+struct profile_sums_offsets
+{
+    profile_sums_offsets()
+      : sowy_(0)
+      , sowyy_(0)
+    {}
+
+    explicit
+    profile_sums_offsets(bn::dtype const & bc_dt)
+    {
+        std::vector<intptr_t> const fields_byte_offsets = bc_dt.get_fields_byte_offsets();
+        sowy_  = fields_byte_offsets[3];
+        sowyy_ = fields_byte_offsets[4];
+    }
+
+    intptr_t sowy_;
+    intptr_t sowyy_;
+};
+
 // template <typename WeightValueType>
 // struct bin_utils;
 //
@@ -56,6 +87,13 @@ struct bin_utils
         return *reinterpret_cast<WeightValueType*>(iter.get_data(op_idx));
     }
 
+    static
+    weight_ref_type
+    get_weight_type_value_from_ptr(char * ptr)
+    {
+        return *reinterpret_cast<WeightValueType*>(ptr);
+    }
+
     static
     void
     increment_bin(char * bc_data_addr, WeightValueType const & weight)
@@ -100,6 +138,65 @@ struct bin_utils
         sow  = WeightValueType(0);
         sows = WeightValueType(0);
     }
+
+    /**
+     * @brief Increments the bin of a profile histogram, i.e. in addition to
+     *     the noe, sow, and sows values, it increments the sum of the weighted
+     *     profile values (sowy) and the sum of the weighted squared profile
+     *     values (sowyy), which are located at the given byte offsets.
+     */
+    static
+    void
+    increment_profile_bin(char * bc_data_addr, WeightValueType const & weight, WeightValueType const & y, profile_sums_offsets const & po)
+    {
+        WeightValueType & sowy  = *reinterpret_cast<WeightValueType*>(bc_data_addr + po.sowy_);
+        WeightValueType & sowyy = *reinterpret_cast<WeightValueType*>(bc_data_addr + po.sowyy_);
+
+        increment_bin(bc_data_addr, weight);
+        WeightValueType const wy = weight * y;
+        sowy  += wy;
+        sowyy += wy * y;
+    }
+
+    static
+    void
+    add_profile_sums(char * dst_addr, char * src_addr, profile_sums_offsets const & po)
+    {
+        *reinterpret_cast<WeightValueType*>(dst_addr + po.sowy_)  += *reinterpret_cast<WeightValueType*>(src_addr + po.sowy_);
+        *reinterpret_cast<WeightValueType*>(dst_addr + po.sowyy_) += *reinterpret_cast<WeightValueType*>(src_addr + po.sowyy_);
+    }
+
+    static
+    void
+    sub_profile_sums(char * dst_addr, char * src_addr, profile_sums_offsets const & po)
+    {
+        *reinterpret_cast<WeightValueType*>(dst_addr + po.sowy_)  -= *reinterpret_cast<WeightValueType*>(src_addr + po.sowy_);
+        *reinterpret_cast<WeightValueType*>(dst_addr + po.sowyy_) -= *reinterpret_cast<WeightValueType*>(src_addr + po.sowyy_);
+    }
+
+    static
+    void
+    imul_profile_sums(char * bc_data_addr, WeightValueType const & value, profile_sums_offsets const & po)
+    {
+        *reinterpret_cast<WeightValueType*>(bc_data_addr + po.sowy_)  *= value;
+        *reinterpret_cast<WeightValueType*>(bc_data_addr + po.sowyy_) *= value;
+    }
+
+    static
+    void
+    idiv_profile_sums(char * bc_data_addr, WeightValueType const & value, profile_sums_offsets const & po)
+    {
+        *reinterpret_cast<WeightValueType*>(bc_data_addr + po.sowy_)  /= value;
+        *reinterpret_cast<WeightValueType*>(bc_data_addr + po.sowyy_) /= value;
+    }
+
+    static
+    void
+    zero_profile_sums(char * bc_data_addr, profile_sums_offsets const & po)
+    {
+        *reinterpret_cast<WeightValueType*>(bc_data_addr + po.sowy_)  = WeightValueType(0);
+        *reinterpret_cast<WeightValueType*>(bc_data_addr + po.sowyy_) = WeightValueType(0);
+    }
 };
 
 template <>
@@ -118,6 +215,15 @@ struct bin_utils<bp::object>
         return value;
     }
 
+    static
+    weight_ref_type
+    get_weight_type_value_from_ptr(char * ptr)
+    {
+        uintptr_t * value_ptr = reinterpret_cast<uintptr_t*>(ptr);
+        bp::object value(bp::detail::borrowed_reference(reinterpret_cast<PyObject*>(*value_ptr)));
+        return value;
+    }
+
     static
     void
     increment_bin(char * bc_data_addr, bp::object const & weight)
@@ -176,6 +282,61 @@ struct bin_utils<bp::object>
         bp::xdecref<PyObject>(reinterpret_cast<PyObject*>(*ptr2));
         *ptr2 = reinterpret_cast<uintptr_t>(bp::incref<PyObject>(sows_obj.ptr()));
     }
+
+    // Profile histograms are not supported for object weight types. The
+    // ndhist constructor prevents the creation of such histograms, so the
+    // following functions are never called in practice.
+    static
+    void
+    throw_profile_not_supported()
+    {
+        std::stringstream ss;
+        ss << "Profile histograms are not supported for the object weight "
+           << "type!";
+        throw TypeError(ss.str());
+    }
+
+    static
+    void
+    increment_profile_bin(char *, bp::object const &, bp::object const &, profile_sums_offsets const &)
+    {
+        throw_profile_not_supported();
+    }
+
+    static
+    void
+    add_profile_sums(char *, char *, profile_sums_offsets const &)
+    {
+        throw_profile_not_supported();
+    }
+
+    static
+    void
+    sub_profile_sums(char *, char *, profile_sums_offsets const &)
+    {
+        throw_profile_not_supported();
+    }
+
+    static
+    void
+    imul_profile_sums(char *, bp::object const &, profile_sums_offsets const &)
+    {
+        throw_profile_not_supported();
+    }
+
+    static
+    void
+    idiv_profile_sums(char *, bp::object const &, profile_sums_offsets const &)
+    {
+        throw_profile_not_supported();
+    }
+
+    static
+    void
+    zero_profile_sums(char *, profile_sums_offsets const &)
+    {
+        throw_profile_not_supported();
+    }
 };
 
 }//namespace detail
@@ -51,6 +51,8 @@ class bytearray
     bytearray(size_t capacity, size_t elsize)
       : data_(calloc_data(capacity, elsize))
       , bytesize_(capacity*elsize)
+      , owns_data_(true)
+      , readonly_(false)
     {}
 
     /**
@@ -59,6 +61,8 @@ class bytearray
     bytearray(bytearray const & ba)
       : data_(calloc_data(ba.bytesize_, 1))
       , bytesize_(ba.bytesize_)
+      , owns_data_(true)
+      , readonly_(false)
     {
         std::cout << "Copying bytearray ..." << std::flush;
         memcpy(data_, ba.data_, bytesize_);
@@ -69,7 +73,7 @@ class bytearray
     ~bytearray()
     {
         std::cout << "Destructing bytearray" << std::endl<<std::flush;
-        if(data_)
+        if(data_ && owns_data_)
         {
             free_data(data_);
         }
@@ -83,8 +87,21 @@ class bytearray
      */
     size_t const bytesize_;
 
+    /** The flag if the data has been allocated by this bytearray, i.e. if it
+     *  needs to be freed upon destruction.
+     */
+    bool const owns_data_;
+
+    /** The flag if the data must not be altered, e.g. because it is a
+     *  read-only memory mapping of a file, or the bin content array of a
+     *  cached projection.
+     */
+    bool readonly_;
+
     /**
-     * @brief Memsets all elements of the byte array to zero.
+     * @brief Sets all elements of the byte array to zero. Large byte arrays,
+     *        which own their data, give their memory pages back to the
+     *        operating system instead (on Linux).
      */
     void
     clear();
@@ -94,6 +111,18 @@ class bytearray
      */
     char * get() const { return data_; }
 
+    /**
+     * @brief Returns ``true`` if the data of this byte array must not be
+     *        altered.
+     */
+    bool is_readonly() const { return readonly_; }
+
+    /**
+     * @brief Marks the data of this byte array as read-only. Ndarrays, which
+     *        have been constructed on top of it before, stay writeable.
+     */
+    void set_readonly() { readonly_ = true; }
+
     /**
      * @brief Creates a deepcopy of this bytearray on the heap.
      */
@@ -105,10 +134,25 @@ class bytearray
         return boost::shared_ptr<bytearray>(new bytearray(*this));
     }
 
+  protected:
+    /**
+     * @brief Constructor for wrapping already existing memory of the given
+     *        size in bytes, e.g. a memory mapped file. The memory is not freed
+     *        by the bytearray, so derived classes need to release it.
+     */
+    bytearray(char * data, size_t bytesize, bool readonly)
+      : data_(data)
+      , bytesize_(bytesize)
+      , owns_data_(false)
+      , readonly_(readonly)
+    {}
+
   private:
     bytearray()
       : data_(NULL)
       , bytesize_(0)
+      , owns_data_(true)
+      , readonly_(false)
     {}
 };
 
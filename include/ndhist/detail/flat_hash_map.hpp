@@ -0,0 +1,166 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_DETAIL_FLAT_HASH_MAP_HPP_INCLUDED
+#define NDHIST_DETAIL_FLAT_HASH_MAP_HPP_INCLUDED 1
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace ndhist {
+namespace detail {
+
+/**
+ * Hash function for 64-bit integer keys. It uses the finalizer of the
+ * splitmix64 generator, so consecutive keys get spread over the entire table.
+ */
+struct int64_hash
+{
+    static
+    uint64_t
+    apply(int64_t const key)
+    {
+        uint64_t h = uint64_t(key);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+};
+
+/**
+ * Hash function for string keys (64-bit FNV-1a).
+ */
+struct string_hash
+{
+    static
+    uint64_t
+    apply(std::string const & key)
+    {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for(std::string::const_iterator it = key.begin(); it != key.end(); ++it)
+        {
+            h ^= uint64_t(static_cast<unsigned char>(*it));
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+};
+
+/**
+ * The flat_hash_map class template maps keys of type KeyType to non-negative
+ * indices. It uses open addressing with linear probing within a flat,
+ * power-of-two sized table, so a lookup touches (usually) only one cache line.
+ * Entries can only be inserted, which is all the category lookups need.
+ * The HashType class must provide a static ``uint64_t apply(KeyType const &)``
+ * function.
+ */
+template <typename KeyType, class HashType>
+class flat_hash_map
+{
+  public:
+    flat_hash_map()
+      : size_(0)
+      , mask_(0)
+    {}
+
+    inline
+    intptr_t
+    get_size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Returns the index that is mapped to the given key, or -1 if the
+     *     key is not part of the map.
+     */
+    inline
+    intptr_t
+    find(KeyType const & key) const
+    {
+        if(size_ == 0) return -1;
+        uintptr_t slot = uintptr_t(HashType::apply(key)) & mask_;
+        while(values_[slot] != -1)
+        {
+            if(keys_[slot] == key) return values_[slot];
+            slot = (slot + 1) & mask_;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Maps the given non-negative index to the given key. The key must
+     *     not be part of the map already.
+     */
+    void
+    insert(KeyType const & key, intptr_t const value)
+    {
+        // Keep the load factor at or below 1/2, so probe sequences stay short.
+        if(2*(size_+1) > intptr_t(values_.size()))
+        {
+            rehash(values_.size() == 0 ? 16 : 2*values_.size());
+        }
+        insert_unchecked(key, value);
+        ++size_;
+    }
+
+    void
+    clear()
+    {
+        keys_.clear();
+        values_.clear();
+        size_ = 0;
+        mask_ = 0;
+    }
+
+  protected:
+    inline
+    void
+    insert_unchecked(KeyType const & key, intptr_t const value)
+    {
+        uintptr_t slot = uintptr_t(HashType::apply(key)) & mask_;
+        while(values_[slot] != -1)
+        {
+            slot = (slot + 1) & mask_;
+        }
+        keys_[slot]   = key;
+        values_[slot] = value;
+    }
+
+    void
+    rehash(uintptr_t const n_slots)
+    {
+        std::vector<KeyType> old_keys(n_slots);
+        std::vector<intptr_t> old_values(n_slots, -1);
+        old_keys.swap(keys_);
+        old_values.swap(values_);
+        mask_ = n_slots - 1;
+        for(uintptr_t i=0; i<old_values.size(); ++i)
+        {
+            if(old_values[i] != -1)
+            {
+                insert_unchecked(old_keys[i], old_values[i]);
+            }
+        }
+    }
+
+    std::vector<KeyType>  keys_;
+    std::vector<intptr_t> values_;
+    intptr_t              size_;
+    uintptr_t             mask_;
+};
+
+}// namespace detail
+}// namespace ndhist
+
+#endif // !NDHIST_DETAIL_FLAT_HASH_MAP_HPP_INCLUDED
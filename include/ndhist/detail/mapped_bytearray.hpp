@@ -0,0 +1,58 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_DETAIL_MAPPED_BYTEARRAY_H_INCLUDED
+#define NDHIST_DETAIL_MAPPED_BYTEARRAY_H_INCLUDED
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <ndhist/detail/bytearray.hpp>
+
+namespace ndhist {
+namespace detail {
+
+/**
+ * @brief The mapped_bytearray class provides a bytearray, whose memory is a
+ *        memory mapping of a region of a file. Pages of the file are read only
+ *        when they are accessed for the first time. The mapping is either
+ *        read-only, or private (copy-on-write), i.e. modifications are never
+ *        written back to the file.
+ */
+class mapped_bytearray
+  : public bytearray
+{
+  public:
+    /**
+     * @brief Maps bytesize bytes of the given open file descriptor, starting
+     *        at the given file offset. The offset must be a multiple of the
+     *        page size of the system. If readonly is set to ``true``, the
+     *        mapping is read-only, otherwise it is copy-on-write. The file
+     *        descriptor can be closed after the mapping has been created.
+     */
+    static
+    boost::shared_ptr<bytearray>
+    create(int fd, std::string const & filename, size_t offset, size_t bytesize, bool readonly);
+
+    virtual
+    ~mapped_bytearray();
+
+  protected:
+    mapped_bytearray(char * data, size_t bytesize, bool readonly)
+      : bytearray(data, bytesize, readonly)
+    {}
+};
+
+}// namespace detail
+}// namespace ndhist
+
+#endif // NDHIST_DETAIL_MAPPED_BYTEARRAY_H_INCLUDED
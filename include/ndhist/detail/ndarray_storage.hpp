@@ -13,6 +13,7 @@
 #define NDHIST_DETAIL_NDARRAY_STORAGE_H_INCLUDED 1
 
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 #include <boost/python.hpp>
@@ -116,6 +117,43 @@ class ndarray_storage
         calc_data_strides(data_strides_, dt_, shape_, front_capacity_, back_capacity_);
     }
 
+    /**
+     * @brief Constructs a new ndarray_storage with the specified data type,
+     *     shape, front- and back capacities, that uses the given (already
+     *     filled) bytearray as data, e.g. a memory mapped file. The size of
+     *     the bytearray must match the array layout.
+     */
+    ndarray_storage(
+        boost::numpy::dtype   const & dt
+      , std::vector<intptr_t> const & shape
+      , std::vector<intptr_t> const & front_capacity
+      , std::vector<intptr_t> const & back_capacity
+      , boost::shared_ptr<bytearray> const & ba
+    )
+      : shape_(shape)
+      , front_capacity_(front_capacity)
+      , back_capacity_(back_capacity)
+      , dt_(bn::dtype(dt))
+      , bytearray_data_offset_(0)
+      , bytearray_(ba)
+    {
+        size_t bytesize = dt_.get_itemsize();
+        for(size_t i=0; i<shape_.size(); ++i)
+        {
+            bytesize *= front_capacity_[i] + shape_[i] + back_capacity_[i];
+        }
+        if(bytearray_->bytesize_ != bytesize)
+        {
+            std::stringstream ss;
+            ss << "The size of the given bytearray is "<< bytearray_->bytesize_
+               << " bytes, but the array layout requires "<< bytesize
+               << " bytes!";
+            throw ValueError(ss.str());
+        }
+        data_strides_.resize(shape_.size());
+        calc_data_strides(data_strides_, dt_, shape_, front_capacity_, back_capacity_);
+    }
+
     /**
      * @brief Constructs a new ndarray_storage that defines a data view into the
      *     bytearray of an other ndarray_storage object.
@@ -155,6 +193,16 @@ class ndarray_storage
         bytearray_->clear();
     }
 
+    /**
+     * @brief Sets all the elements within the shape of this ndarray_storage
+     *     object to zero, leaving the rest of the bytearray untouched, e.g.
+     *     when this storage is a data view. The trailing axes, whose elements
+     *     are contiguous in memory, are cleared with one memset call per
+     *     contiguous block.
+     */
+    void
+    clear_view();
+
     /**
      * @brief Creates a deep copy of this ndarray_storage object, i.e. the
      *     underlaying bytearray is also copied.
@@ -180,7 +228,8 @@ class ndarray_storage
     /**
      * @brief Constructs a boost::numpy::ndarray object wrapping the data of
      *     this ndarray storage with the correct layout, i.e. offset and
-     *     strides.
+     *     strides. If the bytearray is read-only, the ndarray is not
+     *     writeable.
      *     If the field_idx is greater than 0, it is assumed, that the data
      *     storage was created with a structured dtype object and the correct
      *     byte offset will be calculated automatically to select the field
@@ -0,0 +1,142 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_DETAIL_SHADOW_ACCUMULATOR_HPP_INCLUDED
+#define NDHIST_DETAIL_SHADOW_ACCUMULATOR_HPP_INCLUDED 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include <ndhist/limits.hpp>
+
+namespace ndhist {
+namespace detail {
+
+/**
+ * The shadow_accumulator class accumulates the number of entries, the sum of
+ * weights, and the sum of squared weights of bins with float64 weights in a
+ * compact record of 12 bytes (uint32 and 2x float32) per bin, instead of the
+ * 24 bytes of the bin content array. The shadow records are indexed by the
+ * byte offset of the bin within the bin content array divided by the item size
+ * of the bin content array.
+ *
+ * A shadow record is added to the bin content array and is reset to zero
+ * when its number of entries reaches NDHIST_LIMIT_SHADOW_ACCUMULATION_FLUSH_INTERVAL,
+ * and all the touched shadow records are added at the end of a fill. The flush
+ * interval bounds the number of float32 additions per record and thus the
+ * rounding error.
+ */
+class shadow_accumulator
+{
+  public:
+    struct record
+    {
+        uint32_t noe_;
+        float    sow_;
+        float    sows_;
+    };
+
+    shadow_accumulator(intptr_t const n_records)
+      : records_(n_records)
+    {}
+
+    inline
+    intptr_t
+    get_n_records() const
+    {
+        return records_.size();
+    }
+
+    /**
+     * @brief Resizes the shadow array to the given number of records. The
+     *     shadow accumulator must have been flushed before.
+     */
+    inline
+    void
+    resize(intptr_t const n_records)
+    {
+        records_.assign(n_records, record());
+    }
+
+    /**
+     * @brief Adds an entry with the given weight to the shadow record with
+     *     the given index. If the number of entries of the record reaches the
+     *     flush interval, the record is added to the bin of the float64 bin
+     *     content array starting at the given address with the given item
+     *     size.
+     */
+    inline
+    void
+    increment(
+        char * const bc_data
+      , intptr_t const itemsize
+      , intptr_t const idx
+      , double const weight
+    )
+    {
+        record & rec = records_[idx];
+        if(rec.noe_ == 0)
+        {
+            touched_.push_back(idx);
+        }
+        rec.noe_  += 1;
+        rec.sow_  += float(weight);
+        rec.sows_ += float(weight * weight);
+        if(rec.noe_ >= NDHIST_LIMIT_SHADOW_ACCUMULATION_FLUSH_INTERVAL)
+        {
+            // The record stays in the list of touched records, which is
+            // harmless, because flushing a zero record adds nothing.
+            flush_record(bc_data, itemsize, idx);
+        }
+    }
+
+    /**
+     * @brief Adds the touched shadow records to the bins of the float64 bin
+     *     content array starting at the given address with the given item
+     *     size, and resets them to zero.
+     */
+    void
+    flush(char * const bc_data, intptr_t const itemsize)
+    {
+        for(size_t i=0; i<touched_.size(); ++i)
+        {
+            flush_record(bc_data, itemsize, touched_[i]);
+        }
+        touched_.clear();
+    }
+
+  protected:
+    inline
+    void
+    flush_record(char * const bc_data, intptr_t const itemsize, intptr_t const idx)
+    {
+        record & rec = records_[idx];
+        char * const bin_addr = bc_data + idx*itemsize;
+        *reinterpret_cast<uintptr_t*>(bin_addr) += rec.noe_;
+        *reinterpret_cast<double*>(bin_addr + sizeof(uintptr_t)) += rec.sow_;
+        *reinterpret_cast<double*>(bin_addr + sizeof(uintptr_t) + sizeof(double)) += rec.sows_;
+        rec = record();
+    }
+
+  protected:
+    std::vector<record> records_;
+
+    /** The indices of the shadow records, which are non-zero.
+     */
+    std::vector<intptr_t> touched_;
+};
+
+}// namespace detail
+}// namespace ndhist
+
+#endif // !NDHIST_DETAIL_SHADOW_ACCUMULATOR_HPP_INCLUDED
@@ -0,0 +1,184 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_DETAIL_SUMMED_AREA_TABLE_HPP_INCLUDED
+#define NDHIST_DETAIL_SUMMED_AREA_TABLE_HPP_INCLUDED 1
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace ndhist {
+namespace detail {
+
+/**
+ * The summed_area_table class holds the N-dimensional prefix sums of the
+ * number of entries, the sum of weights, and the sum of squared weights of a
+ * bin content array with the given shape. The table has one extra leading
+ * element for each axis, which is always zero, i.e. the table element
+ * (i_0+1, ..., i_{N-1}+1) holds the sums over all the bins (j_0, ..., j_{N-1})
+ * with j_k <= i_k. So the sums over any box of bins can be calculated with
+ * 2^N table lookups, independent of the size of the box.
+ *
+ * The table is filled by setting the bin values via the set_bin method and
+ * then calling the scan method once.
+ */
+class summed_area_table
+{
+  public:
+    summed_area_table(std::vector<intptr_t> const & shape)
+      : shape_(shape)
+      , strides_(shape.size())
+    {
+        intptr_t size = 1;
+        for(intptr_t i=intptr_t(shape_.size())-1; i>=0; --i)
+        {
+            strides_[i] = size;
+            size *= shape_[i] + 1;
+        }
+        noe_.resize(size, 0);
+        sow_.resize(size, 0);
+        sows_.resize(size, 0);
+    }
+
+    inline
+    std::vector<intptr_t> const &
+    get_shape_vector() const
+    {
+        return shape_;
+    }
+
+    /**
+     * @brief Sets the values of the bin with the given indices.
+     */
+    inline
+    void
+    set_bin(std::vector<intptr_t> const & indices, double const noe, double const sow, double const sows)
+    {
+        intptr_t idx = 0;
+        for(size_t i=0; i<indices.size(); ++i)
+        {
+            idx += (indices[i] + 1) * strides_[i];
+        }
+        noe_[idx]  = noe;
+        sow_[idx]  = sow;
+        sows_[idx] = sows;
+    }
+
+    /**
+     * @brief Turns the bin values into the prefix sums through an inclusive
+     *     scan along each axis, one axis after the other.
+     */
+    void
+    scan()
+    {
+        intptr_t const size = noe_.size();
+        for(size_t axis=0; axis<shape_.size(); ++axis)
+        {
+            // The table is split into outer blocks of (shape+1)*stride
+            // elements. Within each block, all the lines along the axis are
+            // scanned simultaneously, row by row, so the innermost loop runs
+            // over contiguous memory.
+            intptr_t const stride = strides_[axis];
+            intptr_t const block_size = (shape_[axis] + 1) * stride;
+            for(intptr_t block=0; block<size; block += block_size)
+            {
+                for(intptr_t row=block+2*stride; row<block+block_size; row += stride)
+                {
+                    double       * noe   = &noe_[row];
+                    double       * sow   = &sow_[row];
+                    double       * sows  = &sows_[row];
+                    double const * pnoe  = noe - stride;
+                    double const * psow  = sow - stride;
+                    double const * psows = sows - stride;
+                    for(intptr_t j=0; j<stride; ++j)
+                    {
+                        noe[j]  += pnoe[j];
+                        sow[j]  += psow[j];
+                        sows[j] += psows[j];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Calculates the sums over the box of bins given by the half-open
+     *     index ranges [lower[i], upper[i]) of each axis i.
+     */
+    void
+    get_box_sums(
+        std::vector<intptr_t> const & lower
+      , std::vector<intptr_t> const & upper
+      , double & noe
+      , double & sow
+      , double & sows
+    ) const
+    {
+        noe  = 0;
+        sow  = 0;
+        sows = 0;
+        uintptr_t const nd = shape_.size();
+        for(uintptr_t i=0; i<nd; ++i)
+        {
+            if(lower[i] >= upper[i])
+            {
+                // The box is empty.
+                return;
+            }
+        }
+
+        // Sum over the 2^N corners of the box, where a corner gets the sign
+        // (-1)^k with k being the number of lower box edges used.
+        uintptr_t const n_corners = uintptr_t(1) << nd;
+        for(uintptr_t corner=0; corner<n_corners; ++corner)
+        {
+            intptr_t idx = 0;
+            bool is_negative = false;
+            for(uintptr_t i=0; i<nd; ++i)
+            {
+                if(corner & (uintptr_t(1) << i))
+                {
+                    idx += lower[i] * strides_[i];
+                    is_negative = !is_negative;
+                }
+                else
+                {
+                    idx += upper[i] * strides_[i];
+                }
+            }
+            if(is_negative)
+            {
+                noe  -= noe_[idx];
+                sow  -= sow_[idx];
+                sows -= sows_[idx];
+            }
+            else
+            {
+                noe  += noe_[idx];
+                sow  += sow_[idx];
+                sows += sows_[idx];
+            }
+        }
+    }
+
+  protected:
+    std::vector<intptr_t> shape_;
+    std::vector<intptr_t> strides_;
+    std::vector<double> noe_;
+    std::vector<double> sow_;
+    std::vector<double> sows_;
+};
+
+}// namespace detail
+}// namespace ndhist
+
+#endif // !NDHIST_DETAIL_SUMMED_AREA_TABLE_HPP_INCLUDED
@@ -0,0 +1,211 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_DETAIL_UNBINNED_MOMENTS_HPP_INCLUDED
+#define NDHIST_DETAIL_UNBINNED_MOMENTS_HPP_INCLUDED 1
+
+#include <boost/python.hpp>
+
+namespace ndhist {
+namespace detail {
+
+/**
+ * The unbinned_moments class accumulates the sum of weights, the weighted mean,
+ * and the weighted sum of squared deviations from the mean of the (unbinned)
+ * values of one axis. The mean and the sum of squared deviations are updated
+ * with the weighted Welford algorithm, which is numerically more stable than
+ * accumulating sum(w*x) and sum(w*x^2) directly.
+ * With negative weights, the sum of weights can cancel to zero, which leaves
+ * the mean undefined. In that case, the mean is left unchanged and only the
+ * sum(w*x^2) power sum is kept, so the moments never become NaN or infinite.
+ */
+class unbinned_moments
+{
+  public:
+    unbinned_moments()
+      : sow_(0)
+      , mean_(0)
+      , m2_(0)
+    {}
+
+    /**
+     * @brief Adds the given value with the given weight.
+     */
+    inline
+    void
+    add(double const x, double const w)
+    {
+        if(w == 0) return;
+        double const sow = sow_ + w;
+        if(sow == 0)
+        {
+            // Skip the mean update and keep sum(w*x^2) in m2_.
+            m2_ += sow_*mean_*mean_ + w*x*x;
+            sow_ = 0;
+            return;
+        }
+        sow_ = sow;
+        double const delta = x - mean_;
+        mean_ += delta * w / sow_;
+        m2_ += w * delta * (x - mean_);
+    }
+
+    /**
+     * @brief Merges the given unbinned_moments object into this object, using
+     *     the parallel algorithm of Chan et al.
+     */
+    inline
+    void
+    merge(unbinned_moments const & other)
+    {
+        double const sow = sow_ + other.sow_;
+        if(sow == 0)
+        {
+            // Skip the mean update and keep sum(w*x^2) in m2_.
+            m2_ += other.m2_ + sow_*mean_*mean_ + other.sow_*other.mean_*other.mean_;
+            sow_ = 0;
+            return;
+        }
+        double const delta = other.mean_ - mean_;
+        mean_ += delta * other.sow_ / sow;
+        m2_ += other.m2_ + delta*delta * sow_ * other.sow_ / sow;
+        sow_ = sow;
+    }
+
+    /**
+     * @brief Removes the given unbinned_moments object, which has been merged
+     *     into this object before, by inverting the merge.
+     */
+    inline
+    void
+    unmerge(unbinned_moments const & other)
+    {
+        double const sow = sow_ - other.sow_;
+        if(sow == 0)
+        {
+            clear();
+            return;
+        }
+        double const mean = (sow_*mean_ - other.sow_*other.mean_) / sow;
+        double const delta = other.mean_ - mean;
+        m2_ -= other.m2_ + delta*delta * sow * other.sow_ / sow_;
+        mean_ = mean;
+        sow_ = sow;
+    }
+
+    /**
+     * @brief Scales all the weights by the given factor. The mean value stays
+     *     the same.
+     */
+    inline
+    void
+    scale(double const factor)
+    {
+        sow_ *= factor;
+        m2_  *= factor;
+    }
+
+    inline
+    void
+    clear()
+    {
+        sow_  = 0;
+        mean_ = 0;
+        m2_   = 0;
+    }
+
+    inline
+    double
+    get_sow() const
+    {
+        return sow_;
+    }
+
+    inline
+    double
+    get_mean() const
+    {
+        return mean_;
+    }
+
+    /**
+     * @brief V[x] = sum(w*(x - E[x])^2) / sum(w)
+     */
+    inline
+    double
+    get_var() const
+    {
+        return m2_ / sow_;
+    }
+
+    /**
+     * @brief Returns sum(w*x).
+     */
+    inline
+    double
+    get_sum_wx() const
+    {
+        return sow_ * mean_;
+    }
+
+    /**
+     * @brief Returns sum(w*x^2).
+     */
+    inline
+    double
+    get_sum_wx2() const
+    {
+        return m2_ + sow_ * mean_*mean_;
+    }
+
+  protected:
+    double sow_;
+    double mean_;
+    double m2_;
+};
+
+/**
+ * @brief Converts the axis value of type AxisValueType at the given address to
+ *     a double value.
+ */
+template <typename AxisValueType>
+double
+axis_value_to_double(char * const value_ptr)
+{
+    return static_cast<double>(*reinterpret_cast<AxisValueType*>(value_ptr));
+}
+
+template <typename WeightValueType>
+struct weight_to_double
+{
+    static
+    double
+    apply(WeightValueType const & weight)
+    {
+        return static_cast<double>(weight);
+    }
+};
+
+template <>
+struct weight_to_double<boost::python::object>
+{
+    static
+    double
+    apply(boost::python::object const & weight)
+    {
+        return boost::python::extract<double>(weight);
+    }
+};
+
+}// namespace detail
+}// namespace ndhist
+
+#endif // !NDHIST_DETAIL_UNBINNED_MOMENTS_HPP_INCLUDED
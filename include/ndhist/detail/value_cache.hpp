@@ -25,6 +25,8 @@ struct cache_entry
 {
     std::vector<intptr_t> relative_indices_;
     WeightValueType weight_;
+    // The profile value of the entry, if the histogram is a profile.
+    WeightValueType y_;
 };
 
 struct ValueCacheBase
@@ -128,12 +130,14 @@ struct ValueCache
     push_back(
         std::vector<intptr_t> const & relative_indices
       , weight_value_type weight
+      , weight_value_type y = weight_value_type()
     )
     {
         std::cout << "ValueCache::push_back at "<< size_ << std::endl<<std::flush;
 
         memcpy(&stack_[size_].relative_indices_[0], &relative_indices[0], relative_indices.size()*sizeof(intptr_t));
         stack_[size_].weight_ = weight;
+        stack_[size_].y_ = y;
         ++size_;
         return (size_ == capacity_);
     }
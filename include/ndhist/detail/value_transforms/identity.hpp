@@ -12,6 +12,8 @@
 #ifndef NDHIST_DETAIL_VALUE_TRANSFORMS_IDENTITY_HPP_INCLUDED
 #define NDHIST_DETAIL_VALUE_TRANSFORMS_IDENTITY_HPP_INCLUDED 1
 
+#include <stdint.h>
+
 namespace ndhist {
 namespace detail {
 namespace value_transforms {
@@ -20,6 +22,10 @@ template <typename ValueType>
 class identity
 {
   public:
+    /** The batched transform of the identity transform is exact.
+     */
+    static bool const is_exact = true;
+
     /** Transforms a given value to itself.
      */
     inline
@@ -39,6 +45,36 @@ class identity
     {
         return value;
     }
+
+    /** Transforms n values at once. The i-th value is located at the address
+     *  values_ptr + i*values_stride.
+     */
+    inline
+    static
+    void
+    transform_n(char * values_ptr, intptr_t const values_stride, intptr_t const n, ValueType * out)
+    {
+        for(intptr_t i=0; i<n; ++i, values_ptr += values_stride)
+        {
+            out[i] = *reinterpret_cast<ValueType *>(values_ptr);
+        }
+    }
+
+    inline
+    static
+    bool
+    is_approx_valid(ValueType const /*value*/)
+    {
+        return true;
+    }
+
+    inline
+    static
+    ValueType
+    approx_tolerance(ValueType const /*tvalue*/)
+    {
+        return ValueType(0);
+    }
 };
 
 }// namespace value_transforms
@@ -29,4 +29,82 @@
         NDHIST_DETAIL_LIMIT_TUPLE_FILL_MAX_ND
 #endif
 
+/**
+ * The default number of slots of the uniform lookup table of a generic axis
+ * with POD edges. Each slot holds a 32-bit edge index, so 4096 slots (16 KiB)
+ * fit into the L1 data cache of most CPUs. Larger tables (sized against the L2
+ * cache) help for many, very unevenly distributed edges. A value of 0 disables
+ * the lookup table.
+ */
+#ifndef NDHIST_LIMIT_GENERIC_AXIS_LUT_SIZE
+    #define NDHIST_LIMIT_GENERIC_AXIS_LUT_SIZE \
+        4096
+#endif
+
+/**
+ * The maximal ratio of the value span (max - min + 1) of the integer categories
+ * of a category axis to the number of its categories, for which the categories
+ * are looked up through a dense offset table. Sparser integer categories are
+ * looked up through a flat hash map.
+ */
+#ifndef NDHIST_LIMIT_CATEGORY_AXIS_DENSE_SPAN_FACTOR
+    #define NDHIST_LIMIT_CATEGORY_AXIS_DENSE_SPAN_FACTOR \
+        4
+#endif
+
+/**
+ * The alignment in bytes of the raw bin content block within a file of the
+ * native ndhist file format. The block must start at a multiple of the page
+ * size of the system that maps the file into memory. 64 KiB covers all common
+ * page sizes (4, 16, and 64 KiB).
+ */
+#ifndef NDHIST_LIMIT_NATIVE_STORAGE_DATA_ALIGNMENT
+    #define NDHIST_LIMIT_NATIVE_STORAGE_DATA_ALIGNMENT \
+        65536
+#endif
+
+/**
+ * The minimal size in bytes of a bytearray, for which clearing the bytearray
+ * gives the memory pages back to the operating system (which maps them to zero
+ * pages upon the next access) instead of writing zeros to them.
+ */
+#ifndef NDHIST_LIMIT_BYTEARRAY_RELEASE_PAGES_MIN_BYTESIZE
+    #define NDHIST_LIMIT_BYTEARRAY_RELEASE_PAGES_MIN_BYTESIZE \
+        67108864
+#endif
+
+/**
+ * The number of values per chunk, in which large fill value arrays are filled,
+ * when their data type needs to be converted into the data type of the axis
+ * (or weight). Only the values of one chunk are converted at a time, which
+ * bounds the memory needed for the converted values.
+ */
+#ifndef NDHIST_LIMIT_FILL_CONVERSION_CHUNK_SIZE
+    #define NDHIST_LIMIT_FILL_CONVERSION_CHUNK_SIZE \
+        65536
+#endif
+
+/**
+ * The number of entries of a bin after which its float32 shadow record of a
+ * float64 histogram is added to the bin content array. The sums of integer
+ * weights w are exact as long as the flush interval times w^2 stays below
+ * 2^24. For other weights, the relative rounding error of a sum is bound by the
+ * flush interval times 2^-24.
+ */
+#ifndef NDHIST_LIMIT_SHADOW_ACCUMULATION_FLUSH_INTERVAL
+    #define NDHIST_LIMIT_SHADOW_ACCUMULATION_FLUSH_INTERVAL \
+        4096
+#endif
+
+/**
+ * The number of values, whose bin indices are searched at once for each axis
+ * by the fill method, using the batched bin search of the axis. It also sets
+ * the size of the stack buffers, with which the batched bin searches and value
+ * transforms process their values.
+ */
+#ifndef NDHIST_LIMIT_FILL_BIN_SEARCH_CHUNK_SIZE
+    #define NDHIST_LIMIT_FILL_BIN_SEARCH_CHUNK_SIZE \
+        256
+#endif
+
 #endif // !NDHIST_LIMITS_HPP_INCLUDED
@@ -18,6 +18,7 @@
 
 #include <cstring>
 #include <iostream>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -34,8 +35,12 @@
 
 #include <ndhist/axis.hpp>
 #include <ndhist/error.hpp>
+#include <ndhist/detail/axis_overlap_matrix.hpp>
 #include <ndhist/detail/limits.hpp>
 #include <ndhist/detail/ndarray_storage.hpp>
+#include <ndhist/detail/shadow_accumulator.hpp>
+#include <ndhist/detail/summed_area_table.hpp>
+#include <ndhist/detail/unbinned_moments.hpp>
 #include <ndhist/detail/value_cache.hpp>
 
 namespace bp = boost::python;
@@ -43,6 +48,10 @@ namespace bn = boost::numpy;
 
 namespace ndhist {
 
+namespace detail {
+struct profile_sums_offsets;
+}// namespace detail
+
 class ndhist
   : public boost::enable_shared_from_this<ndhist>
 {
@@ -67,11 +76,19 @@ class ndhist
      *  In case the bin contents are generic Python objects, the bc_class
      *  argument defines this Python object class and is used to initialize the
      *  bin content array with zeros.
+     *
+     *  If profile is set to ``true``, the histogram is a profile histogram.
+     *  Each bin stores in addition the sum of the weighted profile values
+     *  (sowy) and the sum of the weighted squared profile values (sowyy). The
+     *  profile values are given as an extra value column, i.e. after the axis
+     *  values, when filling the histogram. Profile histograms are only
+     *  supported for numeric (non-bool) POD weight types.
      */
     ndhist(
         bp::tuple const & axes
       , bp::object const & dt
       , bp::object const & bc_class = bp::object()
+      , bool const profile = false
     );
 
     /**
@@ -109,6 +126,17 @@ class ndhist
      */
     ndhist & operator+=(ndhist const & rhs);
 
+    /**
+     * @brief Subtracts the given right-hand-side histogram from this ndhist
+     *        object and returning a reference to this (altered) ndhist object.
+     *        The two histograms need to be compatible to each other. The
+     *        right-hand-side histogram is supposed to be added to this
+     *        histogram before. If the number of entries of any bin of the
+     *        right-hand-side histogram is larger than the one of this
+     *        histogram, a ValueError is raised and nothing is subtracted.
+     */
+    ndhist & operator-=(ndhist const & rhs);
+
     /**
      * @brief Scales (multiplies) the sum of weights and the sum of weights
      *        squared of this histogram by the given scalar value.
@@ -297,6 +325,64 @@ class ndhist
     bp::object
     py_get_binerror_ndarray() const;
 
+    /**
+     * @brief Constructs the sum of the weighted profile values (sowy) ndarray
+     *     of a profile histogram for releasing it to Python.
+     *     The returned ndarray excludes possible under- and overflow bins.
+     * @internal The lifetime of this new object and this ndhist object will be
+     *     managed through the BoostNumpy ndarray_accessor_return() policy.
+     */
+    bp::object
+    py_get_profile_sum_ndarray() const;
+
+    /**
+     * @brief Constructs the sum of the weighted profile values (sowy) ndarray
+     *     of a profile histogram for releasing it to Python.
+     *     In contrast to the py_get_profile_sum_ndarray method, the returned
+     *     ndarray contains the possible under- and overflow bins.
+     * @internal The lifetime of this new object and this ndhist object will be
+     *     managed through the BoostNumpy ndarray_accessor_return() policy.
+     */
+    bp::object
+    py_get_full_profile_sum_ndarray() const;
+
+    /**
+     * @brief Constructs the sum of the weighted squared profile values (sowyy)
+     *     ndarray of a profile histogram for releasing it to Python.
+     *     The returned ndarray excludes possible under- and overflow bins.
+     * @internal The lifetime of this new object and this ndhist object will be
+     *     managed through the BoostNumpy ndarray_accessor_return() policy.
+     */
+    bp::object
+    py_get_profile_squaredsum_ndarray() const;
+
+    /**
+     * @brief Constructs the sum of the weighted squared profile values (sowyy)
+     *     ndarray of a profile histogram for releasing it to Python.
+     *     In contrast to the py_get_profile_squaredsum_ndarray method, the
+     *     returned ndarray contains the possible under- and overflow bins.
+     * @internal The lifetime of this new object and this ndhist object will be
+     *     managed through the BoostNumpy ndarray_accessor_return() policy.
+     */
+    bp::object
+    py_get_full_profile_squaredsum_ndarray() const;
+
+    /**
+     * @brief Constructs a new float64 ndarray holding the weighted mean of the
+     *     profile values of each bin of a profile histogram, i.e. sowy/sow.
+     *     Bins without any weight get NaN.
+     */
+    bp::object
+    py_get_profile_mean_ndarray() const;
+
+    /**
+     * @brief Constructs a new float64 ndarray holding the weighted standard
+     *     deviation of the profile values of each bin of a profile histogram,
+     *     i.e. sqrt(sowyy/sow - (sowy/sow)^2). Bins without any weight get NaN.
+     */
+    bp::object
+    py_get_profile_std_ndarray() const;
+
     /**
      * @brief Returns the ndarray holding the bin edges of the given axis.
      *        Note, that this is always a copy, since the edges are supposed
@@ -506,10 +592,232 @@ class ndhist
     /**
      * @brief Create a new ndhist from this ndhist object, where only the
      *        specified dimensions are included and the others are summed over.
+     *        The projection is taken from the projection cache, if possible,
+     *        and a deep copy of it is returned.
      */
-    ndhist
+    boost::shared_ptr<ndhist>
     project(bp::object const & dims) const;
 
+    /**
+     * @brief Returns the projection of this ndhist object onto the given
+     *        axes. The projection is calculated only if it is not available
+     *        yet in the projection cache or if this ndhist object has been
+     *        modified since it was put into the cache. The returned ndhist
+     *        object is shared with the cache and is read-only.
+     */
+    boost::shared_ptr<ndhist const>
+    get_projection(std::set<intptr_t> const & axes) const;
+
+    /**
+     * @brief Returns the (cached) projection of this ndhist object onto the
+     *        given single axis.
+     */
+    boost::shared_ptr<ndhist const>
+    get_projection(intptr_t const axis) const;
+
+    /**
+     * @brief Returns the (cached) projections of this ndhist object onto the
+     *        given sets of axes. All the projections, which are not available
+     *        in the projection cache, are calculated with a single traversal
+     *        of the bin content array.
+     */
+    std::vector< boost::shared_ptr<ndhist const> >
+    get_projections(std::vector< std::set<intptr_t> > const & axes_sets) const;
+
+    /**
+     * @brief Returns the (cached) projections of this ndhist object onto each
+     *        of its individual axes. The missing projections are calculated
+     *        with a single traversal of the bin content array.
+     */
+    std::vector< boost::shared_ptr<ndhist const> >
+    get_axis_projections() const;
+
+    /**
+     * @brief Returns the cumulative sum of weights along the given axis,
+     *        excluding possible under- and overflow bins, i.e. element i holds
+     *        the sum of weights of the first i+1 bins of the projection onto
+     *        that axis. The array is cached together with the projections and
+     *        is recalculated only if this ndhist object has been modified.
+     */
+    std::vector<double> const &
+    get_axis_cumulative_sow(intptr_t axis) const;
+
+    /**
+     * @brief Returns the summed-area table (i.e. the N-dimensional prefix
+     *        sums) of the number of entries, the sum of weights, and the sum
+     *        of squared weights of all the bins, including under- and
+     *        overflow bins. The table is cached together with the projections
+     *        and is recalculated only if this ndhist object has been
+     *        modified.
+     */
+    boost::shared_ptr<detail::summed_area_table const>
+    get_summed_area_table() const;
+
+    /**
+     * @brief Calculates the number of entries, the sum of weights, and the
+     *        sum of squared weights of the box of bins given by the half-open
+     *        bin index ranges [lower[i], upper[i]) of each axis i. The bin
+     *        indices exclude possible under- and overflow bins. The sums are
+     *        calculated with 2^N lookups into the summed-area table.
+     */
+    void
+    get_integral_sums(
+        std::vector<intptr_t> const & lower
+      , std::vector<intptr_t> const & upper
+      , double & noe
+      , double & sow
+      , double & sows
+    ) const;
+
+    /**
+     * @brief Returns the sum of weights of the box of bins given by the
+     *        ranges sequence, which holds a (start, stop) bin index pair (or
+     *        None for all bins) for each axis. None selects all the bins of
+     *        all axes. Under- and overflow bins are excluded.
+     */
+    double
+    integral(bp::object const & ranges) const;
+
+    /**
+     * @brief Same as integral, but returns the tuple (noe, sow, sows) of the
+     *        number of entries, the sum of weights, and the sum of squared
+     *        weights of the box of bins.
+     */
+    bp::tuple
+    py_get_integral_sums(bp::object const & ranges) const;
+
+    /**
+     * @brief Removes all projections (and the cumulative sum of weights
+     *        arrays) from the projection cache.
+     */
+    void
+    clear_projection_cache() const;
+
+    /**
+     * @brief Returns the modification count of the bin content array. It gets
+     *     incremented by every operation that changes the bin content array,
+     *     i.e. fill, clear, the arithmetic operators, axis extensions, and
+     *     bin merging. For a data view the count of the base ndhist object is
+     *     returned, because the bin content array is shared with it.
+     *     Writes through the ndarray objects returned by the bin content
+     *     properties cannot be tracked, so the release of such a writeable
+     *     ndarray object is counted as a modification.
+     */
+    uintptr_t
+    get_modification_count() const
+    {
+        return (is_view() ? base_->get_modification_count() : modification_count_);
+    }
+
+    /**
+     * @brief Increments the modification count of the bin content array. For
+     *     a data view the count of the base ndhist object is incremented.
+     */
+    void
+    increment_modification_count()
+    {
+        if(is_view())
+        {
+            boost::const_pointer_cast<ndhist, ndhist const>(base_)->increment_modification_count();
+            return;
+        }
+        ++modification_count_;
+    }
+
+    /**
+     * @brief Checks if this ndhist object tracks the unbinned moments of the
+     *     filled axis values.
+     */
+    bool
+    is_tracking_unbinned_moments() const
+    {
+        return track_unbinned_moments_;
+    }
+
+    /**
+     * @brief Enables or disables the tracking of the unbinned sum of weights,
+     *     weighted mean, and weighted variance of the filled values for each
+     *     axis. Enabling it resets the accumulators, so only values filled
+     *     afterwards are taken into account. The accumulators are merged by
+     *     the += operator, scaled by the *= and /= operators, and reset by
+     *     the clear method. If a ndhist object without tracking is added to
+     *     this ndhist object, the tracking gets disabled, because the
+     *     unbinned moments would not be exact anymore.
+     *     Data views and axes with object values do not support the tracking.
+     */
+    void
+    set_track_unbinned_moments(bool const track);
+
+    /**
+     * @brief Checks if this ndhist object accumulates filled values into a
+     *     compact float32 shadow array first.
+     */
+    bool
+    is_using_shadow_accumulation() const
+    {
+        return shadow_accumulation_;
+    }
+
+    /**
+     * @brief Enables or disables the accumulation of filled values into a
+     *     compact shadow array of 12 bytes per bin (uint32 number of entries
+     *     and float32 sums), which is added to the float64 bin content array
+     *     periodically (see NDHIST_LIMIT_SHADOW_ACCUMULATION_FLUSH_INTERVAL)
+     *     and at the end of each fill. It halves the memory touched while
+     *     filling histograms with many bins, at the cost of float32 rounding
+     *     of the weights. Only float64 non-profile histograms, which are not
+     *     data views, support the shadow accumulation.
+     */
+    void
+    set_shadow_accumulation(bool const enable);
+
+    /**
+     * @brief Returns the unbinned moments accumulator of the given axis.
+     *     It throws an exception if the tracking is not enabled.
+     */
+    detail::unbinned_moments const &
+    get_unbinned_moments(intptr_t axis) const;
+
+    /**
+     * @brief Returns the exact weighted mean of the filled values of the given
+     *     axis in O(1).
+     */
+    double
+    get_unbinned_mean(intptr_t axis=0) const;
+
+    /**
+     * @brief Returns the exact weighted variance of the filled values of the
+     *     given axis in O(1).
+     */
+    double
+    get_unbinned_var(intptr_t axis=0) const;
+
+    /**
+     * @brief Returns the tuple (sum(w), sum(w*x), sum(w*x^2)) of the filled
+     *     values of the given axis.
+     */
+    bp::tuple
+    py_get_unbinned_sums(intptr_t axis=0) const;
+
+    /**
+     * @brief Scales the weights of the unbinned moments accumulators of all
+     *     axes by the given factor.
+     */
+    void
+    scale_unbinned_moments(double const factor);
+
+    /**
+     * @brief Creates several projections of this ndhist object at once. The
+     *        *dims_seq* argument is a sequence of dimension specifications,
+     *        each one as accepted by the ``project`` method. In contrast to
+     *        calling ``project`` for each of them, the bin content array of
+     *        this ndhist object is traversed only once.
+     *        It returns a tuple of the projected ndhist objects, in the order
+     *        of the given dimension specifications.
+     */
+    bp::tuple
+    project_many(bp::object const & dims_seq) const;
+
     inline
     std::vector< boost::shared_ptr<Axis> > &
     get_axes()
@@ -559,6 +867,48 @@ class ndhist
         return bc_class_;
     }
 
+    /**
+     * @brief Checks if this ndhist object is a profile histogram.
+     */
+    inline
+    bool
+    is_profile() const
+    {
+        return profile_;
+    }
+
+    /**
+     * @brief Returns the byte offsets of the profile sums within a bin of the
+     *     bin content array, taken from the fields of the bin content data
+     *     type. For a non-profile histogram they are zero.
+     */
+    detail::profile_sums_offsets
+    get_profile_sums_offsets() const;
+
+    /**
+     * @brief Returns the number of value columns needed for filling this
+     *     ndhist object. This is the dimensionality of the histogram plus one
+     *     for the profile value, if this ndhist object is a profile histogram.
+     */
+    inline
+    uintptr_t
+    get_n_fill_columns() const
+    {
+        return nd_ + (profile_ ? 1 : 0);
+    }
+
+    /**
+     * @brief Returns the dtype object of the given fill value column. The
+     *     profile value column has the weight data type, which is a floating
+     *     point type for profile histograms.
+     */
+    inline
+    bn::dtype
+    get_fill_column_dtype(uintptr_t const col) const
+    {
+        return (col < nd_ ? axes_[col]->get_dtype() : bc_weight_dt_);
+    }
+
     /**
      * @brief Checks if this ndhist object shares the bin content array with an
      *     other ndhist object, i.e. does not own the data.
@@ -569,6 +919,17 @@ class ndhist
         return (base_ != NULL);
     }
 
+    /**
+     * @brief Checks if the bin content array of this ndhist object must not
+     *     be altered, e.g. because it is a read-only memory mapping of a file.
+     *     The deepcopy of a read-only ndhist object is not read-only.
+     */
+    bool
+    is_readonly() const
+    {
+        return (bc_.bytearray_ != NULL && bc_.bytearray_->is_readonly());
+    }
+
     /**
      * @brief Merges the specified number of bins of the specified axis.
      *
@@ -594,7 +955,10 @@ class ndhist
 
     /**
      * @brief Same as the rebin_axis method, but allows to specify multiple
-     *     axes to rebin.
+     *     axes to rebin. For non-object weights all axes are rebinned within
+     *     a single pass over the bin content array, which writes directly
+     *     into a new compact bin content array. Hence, no intermediate deep
+     *     copy of the bin content array is made.
      */
     boost::shared_ptr<ndhist>
     merge_bins(
@@ -610,6 +974,31 @@ class ndhist
       , bool const copy=true
     );
 
+    /**
+     * @brief Rebins the specified axis onto the bins given by the new_edges
+     *     array. The new edges must be strictly ascending. Old bins outside of
+     *     the range of the new edges go into the under- or overflow bin, which
+     *     will be created if the axis did not have one yet. If split is
+     *     ``false``, each old bin must lie within exactly one new bin, i.e.
+     *     the new edges must be a subset of the old edges. Otherwise, an old
+     *     bin overlapping with several new bins is split proportional to the
+     *     overlapping lengths. The number of entries of a split bin is
+     *     distributed by cumulative rounding.
+     *
+     *     The rebinned axis is a non-extendable generic axis.
+     *     If this ndhist object is a data view into an other ndhist object, or
+     *     the optional argument *copy* is set to ``true``, a copy of this
+     *     ndhist object is rebinned. Otherwise this ndhist object is rebinned
+     *     directly. It returns the changed (this or the copy) ndhist object.
+     */
+    boost::shared_ptr<ndhist>
+    rebin_to(
+        intptr_t axis
+      , bp::object const & new_edges
+      , bool const split=false
+      , bool const copy=true
+    );
+
     void
     extend_axes(
         std::vector<intptr_t> const & f_n_extra_bins_vec
@@ -677,6 +1066,11 @@ class ndhist
       , bc_noe_dt_(bn::dtype::get_builtin<uintptr_t>())
       , bc_weight_dt_(bn::dtype::get_builtin<void>())
       , bc_class_(bp::object())
+      , profile_(false)
+      , track_unbinned_moments_(false)
+      , shadow_accumulation_(false)
+      , modification_count_(0)
+      , proj_cache_modification_count_(0)
     {};
 
   protected:
@@ -687,6 +1081,47 @@ class ndhist
     void
     setup_function_pointers();
 
+    /**
+     * @brief Raises a ValueError if this ndhist object is read-only. The what
+     *     argument describes the denied operation.
+     */
+    void
+    check_writeable(char const * what) const;
+
+    /**
+     * @brief Counts the release of a writeable ndarray view into the bin
+     *     content array to Python as a modification of the bin content array.
+     */
+    void
+    count_writeable_bc_ndarray_release() const;
+
+    /**
+     * @brief Clears the projection cache if the bin content array has been
+     *     modified since the cached projections have been calculated.
+     */
+    void
+    validate_projection_cache() const;
+
+    /**
+     * @brief Converts the ranges sequence argument of the integral methods
+     *     into the lower and upper bin indices of the box of bins.
+     */
+    void
+    get_integral_box(
+        bp::object const & ranges
+      , std::vector<intptr_t> & lower
+      , std::vector<intptr_t> & upper
+    ) const;
+
+    /**
+     * @brief Creates a deep copy of this ndhist object like the deepcopy
+     *     method does, but the bin content array is still shared with this
+     *     ndhist object. The caller must replace the bin content array of the
+     *     copy before modifying it.
+     */
+    boost::shared_ptr<ndhist>
+    deepcopy_without_bin_content() const;
+
     /**
      * @brief Setups the ndhist's value cache, that depends on the weight data
      *     type.
@@ -727,18 +1162,68 @@ class ndhist
      */
     bp::object const bc_class_;
 
+    /** The flag if this ndhist object is a profile histogram, i.e. if the bin
+     *  content elements hold also the sowy and sowyy sub-elements.
+     */
+    bool const profile_;
+
+    /** The flag if the unbinned moments of the filled axis values are tracked,
+     *  the unbinned moments accumulators, one for each axis, and the
+     *  functions to convert an axis value into a double value, one for each
+     *  axis.
+     */
+    bool track_unbinned_moments_;
+    std::vector<detail::unbinned_moments> unbinned_moments_;
+    std::vector<double (*)(char * const)> axis_value_to_double_fcts_;
+
     boost::shared_ptr<detail::ValueCacheBase> value_cache_;
 
+    /** The flag if filled values are accumulated in a float32 shadow array
+     *  first, and the shadow accumulator. The latter is created by the fill
+     *  method when needed.
+     */
+    bool shadow_accumulation_;
+    boost::shared_ptr<detail::shadow_accumulator> shadow_accumulator_;
+
+    /** The number of modifications of the bin content array. It is used to
+     *  invalidate the projection cache.
+     */
+    uintptr_t modification_count_;
+
+    /** The cache of already calculated projections, keyed by the set of
+     *  projected axes, and the modification count at which the cached
+     *  projections have been calculated.
+     */
+    mutable std::map< std::set<intptr_t>, boost::shared_ptr<ndhist const> > proj_cache_;
+    mutable uintptr_t proj_cache_modification_count_;
+
+    /** The cache of the cumulative sum of weights arrays along the individual
+     *  axes. It is invalidated together with the projection cache.
+     */
+    mutable std::map< intptr_t, std::vector<double> > axis_cumsow_cache_;
+
+    /** The cached summed-area table of the bin content array. It is
+     *  invalidated together with the projection cache.
+     */
+    mutable boost::shared_ptr<detail::summed_area_table const> sat_cache_;
+
     boost::function<void (ndhist &, ndhist const &)> iadd_fct_;
+    boost::function<void (ndhist &, ndhist const &)> isub_fct_;
     boost::function<void (ndhist &, bn::ndarray const &)> idiv_fct_;
     boost::function<void (ndhist &, bn::ndarray const &)> imul_fct_;
     boost::function<std::vector<bn::ndarray> (ndhist const &, axis::out_of_range_t const, size_t const)> get_noe_type_field_axes_oor_ndarrays_fct_;
     boost::function<std::vector<bn::ndarray> (ndhist const &, axis::out_of_range_t const, size_t const)> get_weight_type_field_axes_oor_ndarrays_fct_;
     boost::function<void (ndhist &, bp::object const &, bp::object const &)> fill_fct_;
-    boost::function<ndhist (ndhist const &, std::set<intptr_t> const &)> project_fct_;
+    boost::function<boost::shared_ptr<ndhist> (ndhist const &, std::set<intptr_t> const &)> project_fct_;
+    boost::function<std::vector< boost::shared_ptr<ndhist> > (ndhist const &, std::vector< std::set<intptr_t> > const &)> project_many_fct_;
     boost::function<void (ndhist &, intptr_t, intptr_t)> merge_axis_bins_fct_;
+    boost::function<void (ndhist &, std::vector<intptr_t> const &)> merge_bins_fct_;
+    boost::function<void (ndhist &, intptr_t const, detail::axis_overlap_matrix const &)> rebin_axis_fct_;
     boost::function<void (ndhist &)> clear_fct_;
     boost::function<bn::ndarray (ndhist const &)> get_binerror_ndarray_fct_;
+    boost::function<bn::ndarray (ndhist const &, bool)> get_profile_ndarray_fct_;
+    boost::function<void (ndhist const &, std::vector<double> &)> get_axis_cumsow_fct_;
+    boost::function<void (ndhist const &, detail::summed_area_table &)> fill_summed_area_table_fct_;
 
     /** The title string of the histogram, useful for plotting purposes.
      */
@@ -756,6 +1241,8 @@ ndhist::
 operator*=(T const & rhs)
 {
     // Create a bp::object from the rhs value and check if it is a scalar.
+    check_writeable("scale the bin content of");
+
     bp::object value_obj(rhs);
     if(! bn::is_any_scalar(value_obj))
     {
@@ -768,6 +1255,11 @@ operator*=(T const & rhs)
     // bin content weights (performing automatic type conversion).
     bn::ndarray value_arr = bn::from_object(value_obj, bc_weight_dt_);
     imul_fct_(*this, value_arr);
+    if(track_unbinned_moments_)
+    {
+        scale_unbinned_moments(bp::extract<double>(value_obj)());
+    }
+    increment_modification_count();
     return *this;
 }
 
@@ -777,6 +1269,8 @@ ndhist::
 operator/=(T const & rhs)
 {
     // Create a bp::object from the rhs value and check if it is a scalar.
+    check_writeable("scale the bin content of");
+
     bp::object value_obj(rhs);
     if(! bn::is_any_scalar(value_obj))
     {
@@ -789,6 +1283,11 @@ operator/=(T const & rhs)
     // bin content weights (performing automatic type conversion).
     bn::ndarray value_arr = bn::from_object(value_obj, bc_weight_dt_);
     idiv_fct_(*this, value_arr);
+    if(track_unbinned_moments_)
+    {
+        scale_unbinned_moments(1. / bp::extract<double>(value_obj)());
+    }
+    increment_modification_count();
     return *this;
 }
 
@@ -885,14 +1384,37 @@ struct specific_nd_traits<ND>
                 std::stringstream ss;
                 ss << "The number of elements (" << bp::len(ndvalues_tuple)
                     << ") in the ndvalues tuple must match "
-                    << "the dimensionality (" << BOOST_PP_STRINGIZE(ND)
+                    << "the number of fill value columns (" << BOOST_PP_STRINGIZE(ND)
                     << ") of the histogram.";
+                if(self.is_profile())
+                {
+                    ss << " For a profile histogram the last column holds "
+                       << "the profile values.";
+                }
                 throw ValueError(ss.str());
             }
 
+            // Fill large value columns, that need a data type conversion, in
+            // chunks, so only one chunk at a time gets converted.
+            {
+                std::vector<bp::object> objs;
+                std::vector<bn::dtype> dts;
+                for(intptr_t n=0; n<ND; ++n)
+                {
+                    objs.push_back(ndvalues_tuple[n]);
+                    dts.push_back(self.get_fill_column_dtype(n));
+                }
+                objs.push_back(weight_obj);
+                dts.push_back(bn::dtype::get_builtin<BCValueType>());
+                if(fill_in_conversion_chunks(self, objs, dts, /*pack_values_into_tuple=*/true, &apply))
+                {
+                    return;
+                }
+            }
+
             // Extract the ndarrays from the tuple for the different axes.
             #define NDHIST_IN_NDARRAY(z, n, data) \
-                bn::ndarray BOOST_PP_CAT(ndvalue_arr,n) = bn::from_object(ndvalues_tuple[n], self.get_axes()[n]->get_dtype(), 0, 0, bn::ndarray::ALIGNED);
+                bn::ndarray BOOST_PP_CAT(ndvalue_arr,n) = bn::from_object(ndvalues_tuple[n], self.get_fill_column_dtype(n), 0, 0, bn::ndarray::ALIGNED);
             BOOST_PP_REPEAT(ND, NDHIST_IN_NDARRAY, ~)
             #undef NDHIST_IN_NDARRAY
             bn::ndarray weight_arr = bn::from_object(weight_obj, bn::dtype::get_builtin<BCValueType>(), 0, 0, bn::ndarray::ALIGNED);
@@ -977,7 +1499,7 @@ struct specific_nd_traits<ND>
 #if ND > 1
 else
 #endif
-if(nd_ == ND)
+if(get_n_fill_columns() == ND)
 {
     BOOST_PP_SEQ_FOR_EACH(NDHIST_SPECIFIC_ND_TRAITS_WEIGHT_VALUE_TYPE_SUPPORT, ~, NDHIST_TYPE_SUPPORT_WEIGHT_VALUE_TYPES)
 }
@@ -0,0 +1,67 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_STATS_DETAIL_UTILS_HPP_INCLUDED
+#define NDHIST_STATS_DETAIL_UTILS_HPP_INCLUDED 1
+
+#include <sstream>
+#include <string>
+
+#include <ndhist/axis.hpp>
+#include <ndhist/axes/category_axis.hpp>
+#include <ndhist/error.hpp>
+#include <ndhist/ndhist.hpp>
+
+namespace ndhist {
+namespace stats {
+namespace detail {
+
+/**
+ * @brief Throws a TypeError if the given axis of the given histogram is a
+ *     category axis. The bins of a category axis have no numeric bin centers
+ *     and edges, i.e. the statistics functions are not defined for it.
+ */
+inline
+void
+check_axis_is_not_categorical(
+    ndhist const & h
+  , intptr_t const axis_idx
+  , std::string const & fct_name
+)
+{
+    Axis const & axisbase = h.get_axes()[axis_idx]->get_axis_base();
+    if(dynamic_cast<axes::CategoryAxis const *>(&axisbase))
+    {
+        std::stringstream ss;
+        ss << "The axis "<<axis_idx<<" is a category axis. Category axes are "
+           << "not supported by the "<<fct_name<<" function!";
+        throw TypeError(ss.str());
+    }
+}
+
+/**
+ * @brief Calculates the projections of the given histogram onto all its
+ *     individual axes with a single traversal of the bin content array. The
+ *     per-axis calculations of a statistics function, that is evaluated for
+ *     all axes, take them from the projection cache afterwards.
+ */
+inline
+void
+cache_axis_projections(ndhist const & h)
+{
+    h.get_axis_projections();
+}
+
+}// namespace detail
+}// namespace stats
+}// namespace ndhist
+
+#endif // !NDHIST_STATS_DETAIL_UTILS_HPP_INCLUDED
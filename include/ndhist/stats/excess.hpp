@@ -15,7 +15,7 @@
 #include <boost/python.hpp>
 
 #include <ndhist/ndhist.hpp>
-#include <ndhist/stats/kurtosis.hpp>
+#include <ndhist/stats/moments.hpp>
 
 namespace ndhist {
 namespace stats {
@@ -29,7 +29,7 @@ calc_axis_excess_impl(
   , intptr_t const axis
 )
 {
-    return calc_axis_kurtosis_impl<AxisValueType, WeightValueType>(h, axis) - 3;
+    return calc_axis_moments_impl<AxisValueType, WeightValueType>(h, axis).excess();
 }
 
 }// namespace detail
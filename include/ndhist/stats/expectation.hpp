@@ -43,8 +43,10 @@ calc_axis_expectation_impl(
   , intptr_t const axis
 )
 {
-    // Project the given histogram to the given axis (if nd > 1).
-    ndhist const proj = (h.get_nd() == 1 ? h : h.project(bp::object(axis)));
+    // Get the (cached) projection of the given histogram to the given axis
+    // (if nd > 1).
+    boost::shared_ptr<ndhist const> const proj_ptr = (h.get_nd() == 1 ? boost::shared_ptr<ndhist const>() : h.get_projection(axis));
+    ndhist const & proj = (proj_ptr ? *proj_ptr : h);
 
     // Iterate over the bins (which are along the given axis) and exclude
     // possible under- and overflow bins.
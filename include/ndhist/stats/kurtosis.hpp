@@ -15,8 +15,7 @@
 #include <boost/python.hpp>
 
 #include <ndhist/ndhist.hpp>
-#include <ndhist/stats/expectation.hpp>
-#include <ndhist/stats/var.hpp>
+#include <ndhist/stats/moments.hpp>
 
 namespace ndhist {
 namespace stats {
@@ -30,17 +29,7 @@ calc_axis_kurtosis_impl(
   , intptr_t const axis
 )
 {
-    // Do the projection here, so it won't be done twice.
-    ndhist const proj = (h.get_nd() == 1 ? h : h.project(bp::object(axis)));
-
-    double const expact1 = calc_axis_expectation_impl<AxisValueType, WeightValueType>(proj, 1, axis);
-    double const expact2 = calc_axis_expectation_impl<AxisValueType, WeightValueType>(proj, 2, axis);
-    double const expact3 = calc_axis_expectation_impl<AxisValueType, WeightValueType>(proj, 3, axis);
-    double const expact4 = calc_axis_expectation_impl<AxisValueType, WeightValueType>(proj, 4, axis);
-    double const var = calc_axis_var_impl<AxisValueType, WeightValueType>(proj, axis);
-
-    // Kurtosis[x] = (E[x^4] - 4 E[x] E[x^3] + 6 E[x]^2 E[x^2] - 3 E[x]^4) / V[x]^2
-    return (expact4 - 4*expact1*expact3 + 6*expact1*expact1*expact2 - 3*expact1*expact1*expact1*expact1) / (var*var);
+    return calc_axis_moments_impl<AxisValueType, WeightValueType>(h, axis).kurtosis();
 }
 
 }// namespace detail
@@ -15,7 +15,7 @@
 #include <boost/python.hpp>
 
 #include <ndhist/ndhist.hpp>
-#include <ndhist/stats/expectation.hpp>
+#include <ndhist/stats/moments.hpp>
 
 namespace ndhist {
 namespace stats {
@@ -23,13 +23,13 @@ namespace stats {
 namespace detail {
 
 template <typename AxisValueType, typename WeightValueType>
-AxisValueType
+double
 calc_axis_mean_impl(
     ndhist const & h
   , intptr_t const axis
 )
 {
-    return calc_axis_expectation_impl<AxisValueType, WeightValueType>(h, 1, axis);
+    return calc_axis_moments_impl<AxisValueType, WeightValueType>(h, axis).mean();
 }
 
 }// namespace detail
@@ -39,9 +39,9 @@ namespace py {
 /**
  * @brief Calculates the mean value along the given axis of the given ndhist
  *     object.
- *     Since the mean is equal to the first order expectation, this function
- *     just calls the expectation function to calculate the first order
- *     expectation value.
+ *     It is derived from the power sums of the bin center axis values, that
+ *     are calculated with a single iteration over the bins of the projection
+ *     along that axis (see the moments function).
  *     If None is given as axis, the mean value for all axes of the ndhist
  *     object will be calculated and returned as a tuple. But if the
  *     dimensionality of the ndhist object is 1, a scalar value is returned.
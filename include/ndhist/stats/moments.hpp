@@ -0,0 +1,220 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_STATS_MOMENTS_HPP_INCLUDED
+#define NDHIST_STATS_MOMENTS_HPP_INCLUDED 1
+
+#include <cmath>
+
+#include <boost/python.hpp>
+
+#include <boost/numpy/ndarray.hpp>
+#include <boost/numpy/iterators/multi_flat_iterator.hpp>
+
+#include <ndhist/detail/bin_iter_value_type_traits.hpp>
+#include <ndhist/ndhist.hpp>
+
+namespace ndhist {
+namespace stats {
+
+namespace detail {
+
+/**
+ * The axis_moments class holds the sum of weights weighted power sums of the
+ * bin center axis values up to the order 4, i.e. sum_[n] = sum(sow * x^n).
+ * All the moment based statistics quantities can be derived from these sums.
+ */
+class axis_moments
+{
+  public:
+    axis_moments()
+    {
+        for(intptr_t n=0; n<=4; ++n)
+        {
+            sum_[n] = 0;
+        }
+    }
+
+    /**
+     * @brief Adds the given sum of weights for the given axis value to the
+     *     power sums.
+     */
+    inline
+    void
+    add(double const x, double const sow)
+    {
+        double const x2 = x*x;
+        sum_[0] += sow;
+        sum_[1] += sow*x;
+        sum_[2] += sow*x2;
+        sum_[3] += sow*x2*x;
+        sum_[4] += sow*x2*x2;
+    }
+
+    /**
+     * @brief Returns the n'th order expectation value E[x^n], with n <= 4.
+     */
+    inline
+    double
+    expectation(intptr_t const n) const
+    {
+        return sum_[n] / sum_[0];
+    }
+
+    inline
+    double
+    mean() const
+    {
+        return expectation(1);
+    }
+
+    /**
+     * @brief V[x] = E[x^2] - E[x]^2
+     */
+    inline
+    double
+    var() const
+    {
+        double const e1 = expectation(1);
+        return expectation(2) - e1*e1;
+    }
+
+    inline
+    double
+    stddev() const
+    {
+        return std::sqrt(var());
+    }
+
+    /**
+     * @brief SKEWNESS[x] = ( E[x^3] - 3 V[x] E[x] - E[x]^3 ) / \sqrt{V[x]^3}
+     */
+    inline
+    double
+    skewness() const
+    {
+        double const e1 = expectation(1);
+        double const v = var();
+        return (expectation(3) - 3*v*e1 - e1*e1*e1) / std::sqrt(v*v*v);
+    }
+
+    /**
+     * @brief Kurtosis[x] = (E[x^4] - 4 E[x] E[x^3] + 6 E[x]^2 E[x^2] - 3 E[x]^4) / V[x]^2
+     */
+    inline
+    double
+    kurtosis() const
+    {
+        double const e1 = expectation(1);
+        double const v = var();
+        return (expectation(4) - 4*e1*expectation(3) + 6*e1*e1*expectation(2) - 3*e1*e1*e1*e1) / (v*v);
+    }
+
+    /**
+     * @brief Excess[x] = Kurtosis[x] - 3
+     */
+    inline
+    double
+    excess() const
+    {
+        return kurtosis() - 3;
+    }
+
+    /** The power sums sum(sow * x^n) for n = 0, ..., 4.
+     */
+    double sum_[5];
+};
+
+/**
+ * Calculates the power sums of the bin center axis values, weighted by the sum
+ * of weights in each bin, up to the order 4 along the given axis of the given
+ * ndhist object. It uses the (cached) projection along the given axis and
+ * iterates only once over its bins.
+ */
+template <typename AxisValueType, typename WeightValueType>
+axis_moments
+calc_axis_moments_impl(
+    ndhist const & h
+  , intptr_t const axis
+)
+{
+    // Get the (cached) projection of the given histogram to the given axis
+    // (if nd > 1).
+    boost::shared_ptr<ndhist const> const proj_ptr = (h.get_nd() == 1 ? boost::shared_ptr<ndhist const>() : h.get_projection(axis));
+    ndhist const & proj = (proj_ptr ? *proj_ptr : h);
+
+    // Iterate over the bins (which are along the given axis) and exclude
+    // possible under- and overflow bins.
+    Axis const & theaxis = *proj.get_axes()[0];
+    intptr_t nbins = theaxis.get_n_bins();
+    if(theaxis.has_underflow_bin()) --nbins;
+    if(theaxis.has_overflow_bin()) --nbins;
+    bn::ndarray proj_bincenters_arr = theaxis.get_bincenters_ndarray();
+    bn::ndarray proj_bc_arr = proj.bc_.construct_ndarray(proj.bc_.get_dtype(), 0, /*owner=*/NULL, /*set_owndata_flag=*/false);
+    typedef bn::iterators::multi_flat_iterator<2>::impl<
+                bn::iterators::single_value<AxisValueType>
+              , ::ndhist::detail::bin_iter_value_type_traits<WeightValueType>
+            >
+            multi_iter_t;
+    multi_iter_t iter(
+        proj_bincenters_arr
+      , proj_bc_arr
+      , bn::detail::iter_operand::flags::READONLY::value
+      , bn::detail::iter_operand::flags::READONLY::value
+    );
+
+    // Skip the underflow bin.
+    if(theaxis.has_underflow_bin()) ++iter;
+
+    axis_moments moments;
+    while(nbins > 0)
+    {
+        typename multi_iter_t::multi_references_type multi_value = *iter;
+        typename multi_iter_t::value_ref_type_0 axis_bincenter_value = multi_value.value_0;
+        typename multi_iter_t::value_ref_type_1 bin                  = multi_value.value_1;
+
+        moments.add(axis_bincenter_value, *bin.sow_);
+
+        ++iter;
+        --nbins;
+    }
+    return moments;
+}
+
+}// namespace detail
+
+namespace py {
+
+/**
+ * @brief Calculates the moment based statistics quantities along the given
+ *     axis of the given ndhist object with a single iteration over the bins of
+ *     the projection along that axis. It returns a dictionary with the keys
+ *     ``"mean"``, ``"var"``, ``"std"``, ``"skewness"``, ``"kurtosis"``, and
+ *     ``"excess"``.
+ *     If None is given as axis, the moments for all individual axes of the
+ *     ndhist object will be calculated and returned as a tuple of
+ *     dictionaries. But if the dimensionality of the ndhist object is 1, a
+ *     single dictionary is returned.
+ *
+ * @note This function is only defined for ndhist objects with POD axis values
+ *     AND POD weight values.
+ */
+boost::python::object
+moments(
+    ndhist const & h
+  , boost::python::object const & axis = boost::python::object()
+);
+
+}// namespace py
+}// namespace stats
+}// namespace ndhist
+
+#endif // !NDHIST_STATS_MOMENTS_HPP_INCLUDED
@@ -0,0 +1,145 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#ifndef NDHIST_STATS_QUANTILE_HPP_INCLUDED
+#define NDHIST_STATS_QUANTILE_HPP_INCLUDED 1
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <boost/python.hpp>
+
+#include <boost/numpy/dtype.hpp>
+#include <boost/numpy/ndarray.hpp>
+
+#include <ndhist/error.hpp>
+#include <ndhist/ndhist.hpp>
+
+namespace ndhist {
+namespace stats {
+
+namespace detail {
+
+/**
+ * Calculates the quantile axis values for the given probabilities *qs* along
+ * the given axis of the given ndhist object. The cumulative sum of weights
+ * array along the axis is taken from the ndhist's cache (or calculated once)
+ * and the quantiles are determined by a binary search on this array.
+ * If *interpolate* is set to ``false``, the bin center value of the bin is
+ * returned that contains the quantile, or the upper edge of the bin, if the
+ * quantile coincides with it (as the median function does). Otherwise, the
+ * quantile value is linearly interpolated within that bin. The quantile values
+ * are calculated as double values, so they are not truncated for integer
+ * axes.
+ */
+inline
+void
+calc_axis_quantiles_impl(
+    ndhist const & h
+  , std::vector<double> const & qs
+  , intptr_t const axis
+  , bool const interpolate
+  , std::vector<double> & quantiles
+)
+{
+    std::vector<double> const & cumsow = h.get_axis_cumulative_sow(axis);
+    intptr_t const nbins = cumsow.size();
+    if(nbins == 0 || cumsow[nbins-1] == 0)
+    {
+        std::stringstream ss;
+        ss << "All bin content values are zero. The quantile values are "
+           << "ambiguous in that case!";
+        throw ValueError(ss.str());
+    }
+    double const sow_sum = cumsow[nbins-1];
+
+    // Get the (cached) bin edges and bin centers arrays of the axis as
+    // contiguous double arrays. For a float64 axis these are views into the
+    // cached arrays of the axis. They include possible under- and overflow
+    // bins, so the bin index needs to be shifted by the underflow bin.
+    Axis const & theaxis = *h.get_axes()[axis];
+    bn::dtype const dt = bn::dtype::get_builtin<double>();
+    bn::ndarray const binedges_arr = bn::from_object(theaxis.get_binedges_ndarray(), dt, 1, 1, bn::ndarray::CARRAY_RO);
+    bn::ndarray const bincenters_arr = bn::from_object(theaxis.get_bincenters_ndarray(), dt, 1, 1, bn::ndarray::CARRAY_RO);
+    intptr_t const uf = (theaxis.has_underflow_bin() ? 1 : 0);
+    double const * const binedges = reinterpret_cast<double const *>(binedges_arr.get_data()) + uf;
+    double const * const bincenters = reinterpret_cast<double const *>(bincenters_arr.get_data()) + uf;
+
+    quantiles.resize(qs.size());
+    for(size_t j=0; j<qs.size(); ++j)
+    {
+        double const q = qs[j];
+        if(!(q >= 0 && q <= 1))
+        {
+            std::stringstream ss;
+            ss << "The quantile probability "<< q <<" is not within the "
+               << "interval [0, 1]!";
+            throw ValueError(ss.str());
+        }
+        double const q_sow_sum = q * sow_sum;
+
+        // Find the first bin whose cumulative sum of weights reaches the
+        // quantile sum of weights. For q = 0 this is the first non-empty bin.
+        std::vector<double>::const_iterator const it = (q_sow_sum > 0
+            ? std::lower_bound(cumsow.begin(), cumsow.end(), q_sow_sum)
+            : std::upper_bound(cumsow.begin(), cumsow.end(), 0.)
+        );
+        intptr_t const idx = std::min(intptr_t(it - cumsow.begin()), nbins-1);
+
+        // The lower and upper edges of bin idx are binedges[idx] and
+        // binedges[idx+1], respectively.
+        if(! interpolate)
+        {
+            quantiles[j] = ((cumsow[idx] == q_sow_sum && q_sow_sum > 0) ? binedges[idx+1] : bincenters[idx]);
+            continue;
+        }
+
+        double const prev_sow_sum = (idx == 0 ? 0 : cumsow[idx-1]);
+        double const bin_sow = cumsow[idx] - prev_sow_sum;
+        double const frac = (bin_sow > 0 ? std::min(std::max((q_sow_sum - prev_sow_sum)/bin_sow, 0.), 1.) : 0.);
+        quantiles[j] = binedges[idx] + frac*(binedges[idx+1] - binedges[idx]);
+    }
+}
+
+}// namespace detail
+
+namespace py {
+
+/**
+ * @brief Calculates the quantile values for the given probabilities *q* along
+ *     the given axis of the given ndhist object. The cumulative sum of
+ *     weights along the axis is calculated only once and is cached by the
+ *     ndhist object until it gets modified. All the quantiles are determined
+ *     by binary searches on it.
+ *     If *q* is a scalar, a float scalar is returned, otherwise a
+ *     1-dimensional float64 ndarray holding the quantile values.
+ *     If None is given as axis, the quantiles for all individual axes of the
+ *     ndhist object will be calculated and returned as a tuple. But if the
+ *     dimensionality of the ndhist object is 1, the quantiles of that single
+ *     axis are returned.
+ *
+ * @note This function is only defined for ndhist objects with POD axis values
+ *     AND POD weight values.
+ */
+boost::python::object
+quantile(
+    ndhist const & h
+  , boost::python::object const & q
+  , boost::python::object const & axis = boost::python::object()
+  , bool const interpolate = false
+);
+
+}// namespace py
+}// namespace stats
+}// namespace ndhist
+
+#endif // !NDHIST_STATS_QUANTILE_HPP_INCLUDED
@@ -17,8 +17,7 @@
 #include <boost/python.hpp>
 
 #include <ndhist/ndhist.hpp>
-#include <ndhist/stats/expectation.hpp>
-#include <ndhist/stats/var.hpp>
+#include <ndhist/stats/moments.hpp>
 
 namespace ndhist {
 namespace stats {
@@ -32,15 +31,7 @@ calc_axis_skewness_impl(
   , intptr_t const axis
 )
 {
-    // Do the projection here, so it won't be done twice.
-    ndhist const proj = (h.get_nd() == 1 ? h : h.project(bp::object(axis)));
-
-    double const expectation1 = calc_axis_expectation_impl<AxisValueType, WeightValueType>(proj, 1, axis);
-    double const expectation3 = calc_axis_expectation_impl<AxisValueType, WeightValueType>(proj, 3, axis);
-    double const var = calc_axis_var_impl<AxisValueType, WeightValueType>(proj, axis);
-
-    // SKEWNESS[x] = ( E[x^3] - 3 V[x] E[x] - E[x]^3 ) / \sqrt{V[x]^3}
-    return (expectation3 - 3*var*expectation1 - expectation1*expectation1*expectation1) / std::sqrt(var*var*var);
+    return calc_axis_moments_impl<AxisValueType, WeightValueType>(h, axis).skewness();
 }
 
 }// namespace detail
@@ -17,7 +17,7 @@
 #include <boost/python.hpp>
 
 #include <ndhist/ndhist.hpp>
-#include <ndhist/stats/var.hpp>
+#include <ndhist/stats/moments.hpp>
 
 namespace ndhist {
 namespace stats {
@@ -31,7 +31,7 @@ calc_axis_std_impl(
   , intptr_t const axis
 )
 {
-    return std::sqrt(calc_axis_var_impl<AxisValueType, WeightValueType>(h, axis));
+    return calc_axis_moments_impl<AxisValueType, WeightValueType>(h, axis).stddev();
 }
 
 }// namespace detail
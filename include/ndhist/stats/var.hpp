@@ -15,7 +15,7 @@
 #include <boost/python.hpp>
 
 #include <ndhist/ndhist.hpp>
-#include <ndhist/stats/expectation.hpp>
+#include <ndhist/stats/moments.hpp>
 
 namespace ndhist {
 namespace stats {
@@ -29,14 +29,7 @@ calc_axis_var_impl(
   , intptr_t const axis
 )
 {
-    // Do the projection here, so it won't be done twice.
-    ndhist const proj = (h.get_nd() == 1 ? h : h.project(bp::object(axis)));
-
-    double expectation1 = calc_axis_expectation_impl<AxisValueType, WeightValueType>(proj, 1, axis);
-    double expectation2 = calc_axis_expectation_impl<AxisValueType, WeightValueType>(proj, 2, axis);
-
-    // V[x] = E[x^2] - E[x]^2
-    return expectation2 - expectation1*expectation1;
+    return calc_axis_moments_impl<AxisValueType, WeightValueType>(h, axis).var();
 }
 
 }// namespace detail
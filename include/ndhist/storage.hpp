@@ -75,6 +75,49 @@ histload(
   , std::string const & histgroup
 );
 
+/**
+ * Saves the given ndhist object to the given file using the native ndhist file
+ * format. The file consists of a header, holding the histogram and axes
+ * descriptions, followed by the raw bin content block of the histogram. Both
+ * are written with a single (gathering) write call, without any conversion or
+ * compression.
+ *
+ * @param h The ndhist object that should get stored. Its weight type and all
+ *     its axis value types must be POD types.
+ *
+ * @param f The name of the file. An already existing file will be
+ *     overwritten.
+ *
+ * @note The file is written in the byte order of the machine, so it can only
+ *     be loaded on machines with the same byte order.
+ */
+void
+histsave_native(
+    ndhist const & h
+  , std::string const & f
+);
+
+/**
+ * Loads a ndhist object from the given file, that has been written by the
+ * histsave_native function. The raw bin content block of the file is mapped
+ * into memory, so only the pages of the bin content array that are actually
+ * accessed (e.g. by slices or projections) are read from the file.
+ *
+ * @param f The name of the file.
+ *
+ * @param readonly If set to ``false`` (the default), the mapping is
+ *     copy-on-write, i.e. the loaded ndhist object can be altered, but the
+ *     changes are never written back to the file. If set to ``true``, the
+ *     mapping is read-only and shares its pages with the page cache of the
+ *     file, and the loaded ndhist object cannot be altered (see
+ *     ndhist::is_readonly).
+ */
+boost::shared_ptr<ndhist>
+histload_native(
+    std::string const & f
+  , bool const readonly=false
+);
+
 }// namespace ndhist
 
 #endif // !NDHIST_STORAGE_HPP_INCLUDED
@@ -1,3 +1,6 @@
 import axes
 from core import ndhist
+from decaying import decaying
+from grouped import grouped
 from utils import ndzip
+from window import window
@@ -3,7 +3,7 @@ from __future__ import division
 import math
 import numpy as np
 
-from ndhist.core import generic_axis, linear_axis, log10_axis
+from ndhist.core import category_axis, generic_axis, linear_axis, log10_axis
 
 def linear(start, stop
   , width=1
@@ -211,3 +211,54 @@ def log10(start, stop
     #print(edges)
     axis = log10_axis(edges, label, name, add_underflow_bin, add_overflow_bin, extend, extracap, extracap)
     return axis
+
+def category(categories
+  , label=''
+  , name=''
+  , add_overflow_bin=True
+  , extend=False
+  , extracap=0
+):
+    """Creates a category axis with one bin for each of the given categories.
+
+    :type  categories: sequence of int | sequence of str
+    :param categories: The unique integer or string labels of the categories.
+        Integer categories are looked up through a dense offset table if their
+        value range is compact, otherwise through a hash map.
+
+    :type  label: str
+    :param label: The label of the axis.
+
+    :type  name: str
+    :param name: The name of the axis. It is used to name the axis in a
+        structured numpy ndarray when filling ndvalues through a structured
+        array.
+
+    :type  add_overflow_bin: bool
+    :param add_overflow_bin: The switch, if an overflow bin should be added,
+        which collects all values that are not a category of the axis.
+
+    :type  extend: bool
+    :param extend: The switch if the axis is extendable (True) or not (False).
+        In case it is extendable, no overflow bin will be added and unknown
+        categories will be added as new bins at the back of the axis
+        automatically whenever they are filled.
+
+    :type  extracap: int
+    :param extracap: The number of extra bin capacity for the axis, in case the
+        axis is extendable. A value greater than zero will allocate extra memory
+        to reduce the number of required memory reallocations when new
+        categories get added.
+
+    """
+    categories = np.asarray(categories)
+    if(categories.dtype.kind in 'iub'):
+        categories = categories.astype(np.int64)
+    else:
+        categories = np.array([str(c) for c in categories], dtype=object)
+
+    if(extend):
+        add_overflow_bin = False
+
+    axis = category_axis(categories, label, name, add_overflow_bin, extend, extracap)
+    return axis
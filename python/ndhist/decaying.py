@@ -0,0 +1,116 @@
+import numpy as np
+
+class decaying(object):
+    """The decaying class implements an exponentially decaying histogram,
+    e.g. for rate monitoring, where the content of each bin decays as
+    exp(-t/tau).
+
+    The bin contents are stored in a scaled representation, i.e. the true sum
+    of weights of a bin is the stored sum of weights times a global scale
+    factor (and the true sum of squared weights is the stored one times the
+    squared scale factor). Filling adds w/scale to the stored sums and decaying
+    only updates the scale factor, so a decay costs O(1) instead of a pass over
+    all the bins. Only when the scale factor gets so small, that the stored
+    sums could overflow, the scale factor is multiplied into the stored sums
+    (renormalization).
+
+    The numbers of entries of the bins do not decay.
+
+    """
+    def __init__(self, h, tau):
+        """Creates an exponentially decaying histogram with the binning of the
+        given ndhist object h and the decay time constant tau. The weight data
+        type of h must be a floating point type.
+
+        """
+        if(tau <= 0):
+            raise ValueError(
+                'The decay time constant tau must be positive!')
+        if(not np.issubdtype(h.weight_dtype, np.floating)):
+            raise TypeError(
+                'Decaying histograms require a floating point weight data '+
+                'type!')
+
+        self._h = h.empty_like()
+        self._tau = float(tau)
+        self._scale = 1.
+        # The stored sums of squared weights grow as 1/scale^2. Keeping the
+        # scale factor above max^(-1/4) of the weight data type leaves enough
+        # headroom for summing them up.
+        self._min_scale = 1. / np.finfo(h.weight_dtype).max**0.25
+
+    @property
+    def tau(self):
+        """(read-only) The decay time constant.
+
+        """
+        return self._tau
+
+    @property
+    def scale(self):
+        """(read-only) The current global scale factor of the stored bin
+        contents.
+
+        """
+        return self._scale
+
+    @property
+    def histogram(self):
+        """(read-only) A new ndhist object holding the true (decayed) bin
+        contents.
+
+        """
+        h = self._h.deepcopy()
+        if(self._scale != 1.):
+            h *= self._scale
+        return h
+
+    def fill(self, ndvalues, weight=None):
+        """Fills the given values with the given weights. The weights are
+        divided by the current scale factor before they are added to the
+        stored bin contents. The given weight array itself is not modified.
+
+        """
+        if(weight is None):
+            weight = 1. / self._scale
+        elif(self._scale != 1.):
+            w = np.asarray(weight, dtype=self._h.weight_dtype)
+            if(isinstance(weight, np.ndarray) and np.may_share_memory(w, weight)):
+                # The weight array of the caller is used directly, so the
+                # scaled weights need a new array.
+                weight = w / self._scale
+            else:
+                # The weights have been converted into a new array already,
+                # so scale them in place.
+                w /= self._scale
+                weight = w
+        self._h.fill(ndvalues, weight)
+
+    def decay(self, dt):
+        """Decays the bin contents by the factor exp(-dt/tau). It only updates
+        the global scale factor, unless a renormalization of the stored bin
+        contents is required. The time difference dt must be finite and not
+        negative.
+
+        """
+        if(not np.isfinite(dt) or dt < 0):
+            raise ValueError(
+                'The time difference dt must be finite and not negative!')
+        self._scale *= np.exp(-dt / self._tau)
+        if(self._scale < self._min_scale):
+            self.renormalize()
+
+    def renormalize(self):
+        """Multiplies the global scale factor into the stored bin contents and
+        resets the scale factor to 1.
+
+        """
+        self._h *= self._scale
+        self._scale = 1.
+
+    def clear(self):
+        """Sets all bins to zero and resets the scale factor to 1.
+
+        """
+        self._h.clear()
+        self._scale = 1.
@@ -0,0 +1,82 @@
+import numpy as np
+
+from ndhist import axes
+from ndhist import core
+from ndhist.utils import ndzip
+
+class grouped(object):
+    """The grouped class fills the same observables into one histogram per
+    group key, e.g. per run id or per detector module, in a single pass.
+
+    All the groups are stored in one ndhist object, which has an extendable
+    category axis of the group keys as leading (batch) axis in front of the
+    axes of the given prototype histogram. So the bin content array of each
+    group is a contiguous block within the bin content array. Filling maps the
+    group keys and the values to the bins within the same pass over the
+    values, and unknown keys are added as new groups automatically. The
+    histogram of a single group is a data view into the histogram of all the
+    groups, i.e. it does not copy any data.
+
+    """
+    def __init__(self, h, keys, extracap=0):
+        """Creates a grouped histogram with the binning of the given ndhist
+        object h. The keys argument is the (non-empty) sequence of the initial
+        group keys. It defines also the data type of the keys, i.e. integers or
+        strings. The extracap argument specifies the number of extra groups,
+        for which memory is allocated in advance.
+
+        """
+        group_axis = axes.category(keys, label='group', name='group',
+            extend=True, extracap=extracap)
+        # Use copies of the axes of h, so h itself is not shared.
+        h_axes = h.empty_like().axes
+        self._h = core.ndhist((group_axis,) + tuple(h_axes),
+            dtype=h.weight_dtype, profile=h.is_profile)
+        # The number of value columns, including the profile value column.
+        self._ncolumns = h.ndim + int(h.is_profile)
+
+    @property
+    def keys(self):
+        """(read-only) The array of the group keys, in the order of the groups
+        within the histogram of all groups.
+
+        """
+        return self._h.axes[0].categories
+
+    @property
+    def histogram(self):
+        """(read-only) The ndhist object of all the groups. Its first axis is
+        the category axis of the group keys.
+
+        """
+        return self._h
+
+    def fill_grouped(self, keys, ndvalues, weight=None):
+        """Fills the given values with the given weights into the histograms
+        of the groups given by the keys array, which must have the same length
+        as the values. The values are given the same way as for the fill
+        method of the prototype histogram.
+
+        """
+        if(self._ncolumns == 1 and not isinstance(ndvalues, tuple)):
+            ndvalues = (ndvalues,)
+        if(len(ndvalues) != self._ncolumns):
+            raise ValueError(
+                'The number of value arrays (%d) must match the number of '
+                'fill value columns of the histogram (%d)!'%(
+                len(ndvalues), self._ncolumns))
+        columns = (keys,) + tuple(ndvalues)
+        if(len(columns) > self._h.MAX_TUPLE_FILL_NDIM):
+            columns = ndzip(self._h, *columns)
+        self._h.fill(columns, weight)
+
+    def group(self, key):
+        """Returns the histogram of the group with the given key as a data
+        view into the histogram of all groups.
+
+        """
+        idx = np.flatnonzero(self._h.axes[0].categories == key)
+        if(len(idx) == 0):
+            raise KeyError(
+                'The group %s does not exist!'%(repr(key)))
+        return self._h[int(idx[0])]
@@ -2,6 +2,10 @@ import numpy as np
 
 from ndhist import core
 
+# The maximal number of bytes of a stored HDF array, that are read into memory
+# at once when loading a histogram.
+_HDF_LOAD_BLOCK_NBYTES = 64*1024*1024
+
 def _histsave_handler_hdf(h, f, where, name, overwrite):
     """Saves the given ndhist object to a hdf file using the tables package.
 
@@ -33,6 +37,7 @@ def _histsave_handler_hdf(h, f, where, name, overwrite):
         attrs['ndim'] = h.ndim
         attrs['title'] = h.title
         attrs['weight_dtype'] = h.weight_dtype.str
+        attrs['is_profile'] = h.is_profile
 
         def _save_array(arr, where):
             filters = tables.Filters(complib='blosc', complevel=9)
@@ -56,6 +61,9 @@ def _histsave_handler_hdf(h, f, where, name, overwrite):
         _save_array(h.full_binentries, 'full_binentries')
         _save_array(h.full_bincontent, 'full_bincontent')
         _save_array(h.full_squaredweights, 'full_squaredweights')
+        if(h.is_profile):
+            _save_array(h.full_profile_sum, 'full_profile_sum')
+            _save_array(h.full_profile_squaredsum, 'full_profile_squaredsum')
     except:
         # On error, close the already opened file and re-raise the error.
         if(close_file):
@@ -85,10 +93,23 @@ def _histload_handler_hdf(f, histgroup):
         ndim = int(attrs['ndim'])
         title = str(attrs['title'])
         weight_dtype = np.dtype(attrs['weight_dtype'])
+        # Histograms stored before the support of profile histograms have no
+        # is_profile attribute.
+        is_profile = ('is_profile' in attrs._v_attrnames and
+                      bool(attrs['is_profile']))
 
         def _load_array(name):
             return group._v_children[name].read()
 
+        def _load_array_into(name, dst):
+            # Copy the stored array in blocks of rows along the first axis,
+            # so only one block is held in memory at a time.
+            src = group._v_children[name]
+            row_nbytes = max(1, dst[0:1].nbytes)
+            nrows = max(1, _HDF_LOAD_BLOCK_NBYTES // row_nbytes)
+            for i0 in range(0, dst.shape[0], nrows):
+                dst[i0:i0+nrows] = src[i0:i0+nrows]
+
         # Create the ndhist axis objects for all dimensions.
         axes = []
         for dim in range(0, ndim):
@@ -121,15 +142,18 @@ def _histload_handler_hdf(f, histgroup):
             ))
 
         # Create the (empty) ndhist object.
-        h = core.ndhist(tuple(axes), dtype=weight_dtype)
+        h = core.ndhist(tuple(axes), dtype=weight_dtype, profile=is_profile)
 
         # Set the ndhist's title.
         h.title = title
 
         # Load and assign the data to the histogram.
-        h.full_binentries[...]     = _load_array('full_binentries')
-        h.full_bincontent[...]     = _load_array('full_bincontent')
-        h.full_squaredweights[...] = _load_array('full_squaredweights')
+        _load_array_into('full_binentries',     h.full_binentries)
+        _load_array_into('full_bincontent',     h.full_bincontent)
+        _load_array_into('full_squaredweights', h.full_squaredweights)
+        if(is_profile):
+            _load_array_into('full_profile_sum',        h.full_profile_sum)
+            _load_array_into('full_profile_squaredsum', h.full_profile_squaredsum)
     except:
         # On error, close the already opened file and re-raise the error.
         if(close_file):
@@ -159,7 +183,21 @@ def is_hdf_file(f):
 
     return False
 
-def histsave(h, f, where, name, overwrite=False):
+def is_native_file(f):
+    """Checks if the given file object is recognized as a native ndhist file,
+    i.e. if it is a str object holding a file name with the ``".ndh"``
+    extension.
+
+    :type  f: str
+    :param f: The file object.
+
+    """
+    if(isinstance(f, str) and f[-4:] == '.ndh'):
+        return True
+
+    return False
+
+def histsave(h, f, where=None, name=None, overwrite=False):
     """Saves the given ndhist object to the given file.
 
     It raises a NotImplementedError if the given file type is not supported.
@@ -177,15 +215,20 @@ def histsave(h, f, where, name, overwrite=False):
           - ``".hdf"``
           - ``".h5"``
 
+        The ``".ndh"`` file extension selects the native ndhist file format,
+        which stores exactly one histogram per file (see
+        ``core.histsave_native``). An existing file will be overwritten.
+
     :type  where: str
     :param where: The parent group/location within the file where the histogram
-        should get stored to.
+        should get stored to. It is ignored for native ndhist files.
 
         This argument can also be an instance of a group class, that is
         compatible with the given file type instance.
 
     :type  name: str
-    :param name: The name of the data group for this histogram.
+    :param name: The name of the data group for this histogram. It is ignored
+        for native ndhist files.
 
     :type  overwrite: bool
     :param overwrite: Flag if an existing histogram of the same name should get
@@ -207,6 +250,9 @@ def histsave(h, f, where, name, overwrite=False):
                 'Only ndhist objects with POD axis value types can be stored '+
                 'to a file. Axis "'+idx+'" does not have a POD value type!')
 
+    if(is_native_file(f)):
+        return core.histsave_native(h, f)
+
     try:
         if(is_hdf_file(f)):
             return _histsave_handler_hdf(h, f, where, name, overwrite)
@@ -217,7 +263,7 @@ def histsave(h, f, where, name, overwrite=False):
         'The histogram could not be saved to the given file. No storage '+
         'handler is available for the given file type!')
 
-def histload(f, histgroup):
+def histload(f, histgroup=None, mode='c'):
     """Loads a ndhist object, that is stored within the given group within the
     given file.
 
@@ -233,14 +279,40 @@ def histload(f, histgroup):
           - ``".hdf"``
           - ``".h5"``
 
+        Native ndhist files (``".ndh"``) are mapped into memory, so only the
+        accessed parts of the bin content are read from the file.
+
     :type  histgroup: str
     :param histgroup: The data group name within the file where the histogram is
-        stored in. It's the group created by the histsave function.
+        stored in. It's the group created by the histsave function. It is
+        ignored for native ndhist files.
 
         This argument can also be an instance of a group class, that is
         compatible with the given file type instance.
 
+    :type  mode: str
+    :param mode: The load mode for native ndhist files. ``'c'`` (the default)
+        maps the stored bin content copy-on-write, i.e. the histogram can be
+        altered but the changes are never written back to the file. ``'r'``
+        maps the stored bin content read-only, i.e. the histogram cannot be
+        altered (see ``ndhist.is_readonly``), but its deepcopy can.
+        HDF files are always loaded into memory (their compressed data
+        cannot be mapped), so only ``'c'`` is supported for them.
+
     """
+    if(mode not in ('c', 'r')):
+        raise ValueError(
+            'The load mode must be either "c" (copy-on-write) or "r" '+
+            '(read-only)!')
+
+    if(is_native_file(f)):
+        return core.histload_native(f, readonly=(mode == 'r'))
+
+    if(mode != 'c'):
+        raise ValueError(
+            'The read-only load mode is only supported for native ndhist '+
+            'files!')
+
     try:
         if(is_hdf_file(f)):
             return _histload_handler_hdf(f, histgroup)
@@ -0,0 +1,93 @@
+class window(object):
+    """The window class implements a sliding-window histogram, e.g. a
+    histogram of the last 60 minutes of a time series. It consists of a ring
+    buffer of nslices histograms (slices) with the binning of a given
+    prototype histogram, and of a running total histogram over all the slices.
+
+    Values are filled into the current slice and into the total. Advancing the
+    window subtracts the oldest slice from the total and reuses it as the new
+    current slice. So the total is updated incrementally with a single pass
+    over the bins per advance, instead of summing up all the slices.
+
+    """
+    def __init__(self, h, nslices):
+        """Creates a sliding-window histogram with nslices slices, which have
+        the binning of the given ndhist object h. Histograms with extendable
+        axes are not supported, because the slices would not stay compatible
+        with each other.
+
+        """
+        if(nslices < 1):
+            raise ValueError(
+                'The number of slices must be at least 1!')
+        for axis in h.axes:
+            if(axis.is_extendable):
+                raise ValueError(
+                    'Sliding-window histograms do not support extendable '+
+                    'axes!')
+
+        self._total = h.empty_like()
+        self._slices = [ h.empty_like() for i in range(nslices) ]
+        self._current_idx = 0
+
+    @property
+    def nslices(self):
+        """(read-only) The number of slices of the window.
+
+        """
+        return len(self._slices)
+
+    @property
+    def current(self):
+        """(read-only) The ndhist object of the current slice, i.e. the slice
+        values are filled into.
+
+        """
+        return self._slices[self._current_idx]
+
+    @property
+    def slices(self):
+        """(read-only) The tuple of the ndhist objects of all the slices,
+        ordered from the oldest to the current slice.
+
+        """
+        n = len(self._slices)
+        return tuple([ self._slices[(self._current_idx + 1 + i) % n]
+                       for i in range(n) ])
+
+    @property
+    def total(self):
+        """(read-only) The ndhist object holding the sum over all the slices of
+        the window. It must not be altered directly.
+
+        """
+        return self._total
+
+    def fill(self, ndvalues, weight=None):
+        """Fills the given values with the given weights into the current
+        slice and into the total of the window.
+
+        """
+        self._slices[self._current_idx].fill(ndvalues, weight)
+        self._total.fill(ndvalues, weight)
+
+    def advance(self, n=1):
+        """Advances the window by n slices. The n oldest slices leave the
+        window and are subtracted from the total. They get cleared and become
+        the new (empty) slices.
+
+        """
+        nslices = len(self._slices)
+        if(n >= nslices):
+            # All slices leave the window.
+            self._total.clear()
+            for h in self._slices:
+                h.clear()
+            self._current_idx = (self._current_idx + n) % nslices
+            return
+
+        for i in range(n):
+            self._current_idx = (self._current_idx + 1) % nslices
+            h = self._slices[self._current_idx]
+            self._total -= h
+            h.clear()
@@ -9,6 +9,11 @@
  * (See LICENSE file).
  *
  */
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <stdint.h>
+
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
@@ -17,6 +22,7 @@
 
 #include <ndhist/detail/bytearray.hpp>
 #include <ndhist/error.hpp>
+#include <ndhist/limits.hpp>
 
 namespace ndhist {
 namespace detail {
@@ -48,6 +54,28 @@ void
 bytearray::
 clear()
 {
+#if defined(__linux__)
+    // Large chunks of memory allocated by this bytearray are private anonymous
+    // memory. Instead of writing zeros to all their pages, the pages are given
+    // back to the kernel, which maps them to zero pages upon the next access.
+    // Only the partial pages at the beginning and the end need to be memset.
+    if(owns_data_ && bytesize_ >= NDHIST_LIMIT_BYTEARRAY_RELEASE_PAGES_MIN_BYTESIZE)
+    {
+        uintptr_t const pagesize = sysconf(_SC_PAGESIZE);
+        uintptr_t const begin = uintptr_t(data_);
+        uintptr_t const end = begin + bytesize_;
+        uintptr_t const pages_begin = (begin + pagesize - 1) / pagesize * pagesize;
+        uintptr_t const pages_end = end / pagesize * pagesize;
+        if(   pages_begin < pages_end
+           && madvise(reinterpret_cast<void *>(pages_begin), pages_end - pages_begin, MADV_DONTNEED) == 0
+          )
+        {
+            memset(data_, 0, pages_begin - begin);
+            memset(reinterpret_cast<char *>(pages_end), 0, end - pages_end);
+            return;
+        }
+    }
+#endif
     memset(data_, 0, bytesize_);
 }
 
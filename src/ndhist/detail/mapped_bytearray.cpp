@@ -0,0 +1,50 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <sstream>
+
+#include <ndhist/detail/mapped_bytearray.hpp>
+#include <ndhist/error.hpp>
+
+namespace ndhist {
+namespace detail {
+
+boost::shared_ptr<bytearray>
+mapped_bytearray::
+create(int fd, std::string const & filename, size_t offset, size_t bytesize, bool readonly)
+{
+    // A read-only mapping can share the pages with the page cache of the file.
+    int const prot  = (readonly ? PROT_READ  : PROT_READ | PROT_WRITE);
+    int const flags = (readonly ? MAP_SHARED : MAP_PRIVATE);
+    void * addr = mmap(NULL, bytesize, prot, flags, fd, off_t(offset));
+    if(addr == MAP_FAILED)
+    {
+        std::stringstream ss;
+        ss << "Unable to map " << bytesize << " bytes of the file \""
+           << filename << "\" into memory: " << strerror(errno);
+        throw MemoryError(ss.str());
+    }
+    return boost::shared_ptr<bytearray>(new mapped_bytearray(static_cast<char *>(addr), bytesize, readonly));
+}
+
+mapped_bytearray::
+~mapped_bytearray()
+{
+    munmap(data_, bytesize_);
+}
+
+}// namespace detail
+}// namespace ndhist
@@ -11,6 +11,7 @@
  */
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 
 #include <iostream>
 #include <sstream>
@@ -95,7 +96,12 @@ construct_ndarray(
     std::vector<intptr_t> strides(shape.size());
     calc_data_strides(strides, storage.get_dtype(), shape, front_capacity, back_capacity);
 
-    return bn::from_data(storage.get_data() + data_offset, dt, shape, strides, data_owner, set_owndata_flag);
+    bn::ndarray arr = bn::from_data(storage.get_data() + data_offset, dt, shape, strides, data_owner, set_owndata_flag);
+    if(storage.bytearray_->is_readonly())
+    {
+        arr.attr("setflags")(false);
+    }
+    return arr;
 }
 
 void
@@ -153,7 +159,12 @@ construct_ndarray(
     intptr_t const sub_item_byte_offset = (field_idx == 0 ? 0 : dt_.get_fields_byte_offsets()[field_idx]);
     intptr_t const data_offset = bytearray_data_offset_ + calc_first_shape_element_data_offset(dt_, shape_, front_capacity_, back_capacity_, sub_item_byte_offset);
 
-    return bn::from_data(get_data() + data_offset, dt, shape_, data_strides_, data_owner, set_owndata_flag);
+    bn::ndarray arr = bn::from_data(get_data() + data_offset, dt, shape_, data_strides_, data_owner, set_owndata_flag);
+    if(bytearray_->is_readonly())
+    {
+        arr.attr("setflags")(false);
+    }
+    return arr;
 }
 
 void
@@ -345,6 +356,55 @@ copy_from(
     }
 }
 
+void
+ndarray_storage::
+clear_view()
+{
+    int const nd = get_nd();
+    for(int i=0; i<nd; ++i)
+    {
+        if(shape_[i] == 0)
+        {
+            return;
+        }
+    }
+
+    // Merge the trailing axes, whose elements are contiguous in memory, into
+    // one block of memory.
+    intptr_t block_bytesize = dt_.get_itemsize();
+    int n_outer = nd;
+    while(n_outer > 0 && data_strides_[n_outer-1] == block_bytesize)
+    {
+        block_bytesize *= shape_[n_outer-1];
+        --n_outer;
+    }
+
+    // Iterate over the indices of the outer axes and clear each block.
+    char * addr = bytearray_->get() + bytearray_data_offset_ + calc_first_shape_element_data_offset();
+    std::vector<intptr_t> indices(n_outer, 0);
+    while(true)
+    {
+        memset(addr, 0, block_bytesize);
+
+        int i = n_outer-1;
+        for(; i>=0; --i)
+        {
+            ++indices[i];
+            addr += data_strides_[i];
+            if(indices[i] < shape_[i])
+            {
+                break;
+            }
+            addr -= indices[i]*data_strides_[i];
+            indices[i] = 0;
+        }
+        if(i < 0)
+        {
+            break;
+        }
+    }
+}
+
 boost::shared_ptr<bytearray>
 ndarray_storage::
 create_bytearray(
@@ -13,6 +13,7 @@
 #include <bitset>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <sstream>
 
 #include <boost/preprocessor/seq/for_each.hpp>
@@ -37,7 +38,10 @@
 #include <ndhist/ndhist.hpp>
 #include <ndhist/axis.hpp>
 #include <ndhist/type_support.hpp>
+#include <ndhist/axes/category_axis.hpp>
+#include <ndhist/axes/generic_axis.hpp>
 //#include <ndhist/detail/axis_index_iter.hpp>
+#include <ndhist/detail/axis_overlap_matrix.hpp>
 #include <ndhist/detail/bin_iter_value_type_traits.hpp>
 #include <ndhist/detail/bin_value.hpp>
 #include <ndhist/detail/bin_utils.hpp>
@@ -45,6 +49,8 @@
 #include <ndhist/detail/multi_axis_iter.hpp>
 #include <ndhist/detail/py_arg_inspector.hpp>
 #include <ndhist/detail/py_seq_inspector.hpp>
+#include <ndhist/detail/summed_area_table.hpp>
+#include <ndhist/detail/unbinned_moments.hpp>
 #include <ndhist/detail/utils.hpp>
 
 namespace bp = boost::python;
@@ -65,6 +71,8 @@ flush_value_cache(
 )
 {
     intptr_t const nd = self.get_nd();
+    bool const is_profile = self.is_profile();
+    profile_sums_offsets const po = self.get_profile_sums_offsets();
 
     // Fill in the cached values.
     char * bin_data_addr;
@@ -83,15 +91,124 @@ flush_value_cache(
             bin_data_addr += (f_n_extra_bins_vec[axis] + entry.relative_indices_[axis]) * arr_strides[axis];
         }
 
-        bin_utils<WeightValueType>::increment_bin(bin_data_addr, entry.weight_);
+        if(is_profile)
+        {
+            bin_utils<WeightValueType>::increment_profile_bin(bin_data_addr, entry.weight_, entry.y_, po);
+        }
+        else
+        {
+            bin_utils<WeightValueType>::increment_bin(bin_data_addr, entry.weight_);
+        }
     }
 
     // Finally, clear the stack.
     value_cache.clear();
 }
 
-template <typename BCValueType>
-struct iadd_fct_traits
+/**
+ * The iadd_op and isub_op classes define the bin operations of the += and -=
+ * operators, respectively, for the inplace_op_fct_traits template.
+ */
+struct iadd_op
+{
+    static
+    char const *
+    get_operator_str()
+    {
+        return "+=";
+    }
+
+    template <typename T>
+    static
+    void
+    apply(T & self_value, T const & other_value)
+    {
+        self_value += other_value;
+    }
+
+    template <typename BCValueType>
+    static
+    void
+    apply_profile_sums(char * self_bin_addr, char * other_bin_addr, profile_sums_offsets const & po)
+    {
+        bin_utils<BCValueType>::add_profile_sums(self_bin_addr, other_bin_addr, po);
+    }
+};
+
+struct isub_op
+{
+    static
+    char const *
+    get_operator_str()
+    {
+        return "-=";
+    }
+
+    template <typename T>
+    static
+    void
+    apply(T & self_value, T const & other_value)
+    {
+        self_value -= other_value;
+    }
+
+    template <typename BCValueType>
+    static
+    void
+    apply_profile_sums(char * self_bin_addr, char * other_bin_addr, profile_sums_offsets const & po)
+    {
+        bin_utils<BCValueType>::sub_profile_sums(self_bin_addr, other_bin_addr, po);
+    }
+};
+
+/**
+ * Checks that the number of entries of each bin of the self ndhist object is
+ * not smaller than the one of the corresponding bin of the other ndhist
+ * object, i.e. that the other ndhist object can be subtracted from the self
+ * ndhist object. Otherwise a ValueError is raised.
+ */
+template <typename Operation>
+struct check_inplace_op_noe
+{
+    template <typename MultiIterT>
+    static
+    void
+    apply(bn::ndarray &, bn::ndarray &)
+    {}
+};
+
+template <>
+struct check_inplace_op_noe<isub_op>
+{
+    template <typename MultiIterT>
+    static
+    void
+    apply(bn::ndarray & self_bc_arr, bn::ndarray & other_bc_arr)
+    {
+        MultiIterT bc_it(
+            self_bc_arr
+          , other_bc_arr
+          , boost::numpy::detail::iter_operand::flags::READONLY::value
+          , boost::numpy::detail::iter_operand::flags::READONLY::value);
+        while(! bc_it.is_end())
+        {
+            typename MultiIterT::multi_references_type multi_value = *bc_it;
+            if(*multi_value.value_0.noe_ < *multi_value.value_1.noe_)
+            {
+                std::stringstream ss;
+                ss << "The number of entries of a bin of the subtrahend ("
+                   << *multi_value.value_1.noe_ << ") is larger than the one "
+                   << "of the corresponding bin of the minuend ("
+                   << *multi_value.value_0.noe_ << ")!";
+                throw ValueError(ss.str());
+            }
+            ++bc_it;
+        }
+    }
+};
+
+template <typename BCValueType, typename Operation>
+struct inplace_op_fct_traits
 {
     static
     void apply(ndhist & self, ndhist const & other)
@@ -99,12 +216,12 @@ struct iadd_fct_traits
         if(! self.is_compatible(other))
         {
             std::stringstream ss;
-            ss << "The += operator is only defined for two compatible ndhist "
-               << "objects!";
+            ss << "The " << Operation::get_operator_str() << " operator is "
+               << "only defined for two compatible ndhist objects!";
             throw AssertionError(ss.str());
         }
 
-        // Add the bin contents of the two ndhist objects.
+        // Apply the operation to the bin contents of the two ndhist objects.
         typedef bn::iterators::multi_flat_iterator<2>::impl<
                     bin_iter_value_type_traits<BCValueType>
                   , bin_iter_value_type_traits<BCValueType>
@@ -113,19 +230,31 @@ struct iadd_fct_traits
 
         bn::ndarray self_bc_arr = self.bc_.construct_ndarray(self.bc_.get_dtype(), 0, /*owner=*/NULL, /*set_owndata_flag=*/false);
         bn::ndarray other_bc_arr = other.bc_.construct_ndarray(other.bc_.get_dtype(), 0, /*owner=*/NULL, /*set_owndata_flag=*/false);
+
+        // Check all the bins before altering any of them.
+        check_inplace_op_noe<Operation>::template apply<multi_iter_t>(self_bc_arr, other_bc_arr);
+
         multi_iter_t bc_it(
             self_bc_arr
           , other_bc_arr
           , boost::numpy::detail::iter_operand::flags::READWRITE::value
           , boost::numpy::detail::iter_operand::flags::READONLY::value);
+
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
         while(! bc_it.is_end())
         {
             typename multi_iter_t::multi_references_type multi_value = *bc_it;
             typename multi_iter_t::value_ref_type_0 self_bin_value  = multi_value.value_0;
             typename multi_iter_t::value_ref_type_1 other_bin_value = multi_value.value_1;
-            *self_bin_value.noe_  += *other_bin_value.noe_;
-            *self_bin_value.sow_  += *other_bin_value.sow_;
-            *self_bin_value.sows_ += *other_bin_value.sows_;
+            Operation::apply(*self_bin_value.noe_,  *other_bin_value.noe_);
+            Operation::apply(*self_bin_value.sow_,  *other_bin_value.sow_);
+            Operation::apply(*self_bin_value.sows_, *other_bin_value.sows_);
+            if(is_profile)
+            {
+                // The noe_ pointer points to the beginning of the bin.
+                Operation::template apply_profile_sums<BCValueType>(reinterpret_cast<char*>(self_bin_value.noe_), reinterpret_cast<char*>(other_bin_value.noe_), po);
+            }
             ++bc_it;
         }
     }
@@ -152,6 +281,8 @@ struct idiv_fct_traits
           , boost::numpy::detail::iter_operand::flags::READWRITE::value
           , boost::numpy::detail::iter_operand::flags::READONLY::value
         );
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
         while(! bc_it.is_end())
         {
             typename multi_iter_t::multi_references_type multi_value = *bc_it;
@@ -159,6 +290,11 @@ struct idiv_fct_traits
             typename multi_iter_t::value_ref_type_1 value          = multi_value.value_1;
             *self_bin_value.sow_  /= value;
             *self_bin_value.sows_ /= value * value;
+            if(is_profile)
+            {
+                // The sowy and sowyy values scale like the sow value.
+                bin_utils<BCValueType>::idiv_profile_sums(reinterpret_cast<char*>(self_bin_value.noe_), value, po);
+            }
             ++bc_it;
         }
     }
@@ -185,6 +321,8 @@ struct imul_fct_traits
           , boost::numpy::detail::iter_operand::flags::READWRITE::value
           , boost::numpy::detail::iter_operand::flags::READONLY::value
         );
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
         while(! bc_it.is_end())
         {
             typename multi_iter_t::multi_references_type multi_value = *bc_it;
@@ -192,6 +330,11 @@ struct imul_fct_traits
             typename multi_iter_t::value_ref_type_1 value          = multi_value.value_1;
             *self_bin_value.sow_  *= value;
             *self_bin_value.sows_ *= value * value;
+            if(is_profile)
+            {
+                // The sowy and sowyy values scale like the sow value.
+                bin_utils<BCValueType>::imul_profile_sums(reinterpret_cast<char*>(self_bin_value.noe_), value, po);
+            }
             ++bc_it;
         }
     }
@@ -201,12 +344,14 @@ template <typename WeightValueType>
 struct project_fct_traits
 {
     static
-    ndhist
+    boost::shared_ptr<ndhist>
     apply(ndhist const & self, std::set<intptr_t> const & axes)
     {
         // Create a ndhist with the dimensions specified by axes.
         uintptr_t const self_nd = self.get_nd();
         uintptr_t const proj_nd = axes.size();
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
 
         bp::list axis_list;
         std::set<intptr_t>::const_iterator axes_it = axes.begin();
@@ -217,7 +362,8 @@ struct project_fct_traits
             std::cout << "project: got axis "<<*axes_it<<std::endl;
         }
         bp::tuple axes_tuple(axis_list);
-        ndhist proj(axes_tuple, self.bc_weight_dt_, self.bc_class_);
+        boost::shared_ptr<ndhist> proj_ptr(new ndhist(axes_tuple, self.bc_weight_dt_, self.bc_class_, self.is_profile()));
+        ndhist & proj = *proj_ptr;
 
         typedef multi_axis_iter< bin_iter_value_type_traits<WeightValueType> >
                 multi_axis_iter_t;
@@ -267,6 +413,10 @@ struct project_fct_traits
                 *proj_bin.noe_  += *self_bin.noe_;
                 *proj_bin.sow_  += *self_bin.sow_;
                 *proj_bin.sows_ += *self_bin.sows_;
+                if(is_profile)
+                {
+                    bin_utils<WeightValueType>::add_profile_sums(proj_iter.get_data(), self_iter.get_data(), po);
+                }
 
                 self_iter.increment();
             }
@@ -274,7 +424,90 @@ struct project_fct_traits
             proj_iter.increment();
         }
 
-        return proj;
+        return proj_ptr;
+    }
+};
+
+template <typename WeightValueType>
+struct project_many_fct_traits
+{
+    static
+    std::vector< boost::shared_ptr<ndhist> >
+    apply(ndhist const & self, std::vector< std::set<intptr_t> > const & axes_sets)
+    {
+        typedef bin_iter_value_type_traits<WeightValueType>
+                bin_vtt_t;
+        typedef multi_axis_iter<bin_vtt_t>
+                multi_axis_iter_t;
+
+        uintptr_t const n_projs = axes_sets.size();
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
+
+        // Create all the projection ndhist objects and pre-compute for each of
+        // them the address of its first bin (including the under- and
+        // overflow bins) and its data strides, so the projection bin of a
+        // given self bin can be calculated directly from the self bin indices.
+        std::vector< boost::shared_ptr<ndhist> > projs;
+        projs.reserve(n_projs);
+        std::vector< std::vector<intptr_t> > projs_axes(n_projs);
+        std::vector< std::vector<intptr_t> > projs_strides(n_projs);
+        std::vector<char *> projs_data(n_projs);
+        std::vector<bin_vtt_t> projs_vtt;
+        projs_vtt.reserve(n_projs);
+        for(uintptr_t p=0; p<n_projs; ++p)
+        {
+            bp::list axis_list;
+            std::set<intptr_t>::const_iterator axes_it = axes_sets[p].begin();
+            std::set<intptr_t>::const_iterator const axes_end = axes_sets[p].end();
+            for(; axes_it != axes_end; ++axes_it)
+            {
+                axis_list.append(self.axes_[*axes_it]);
+                projs_axes[p].push_back(*axes_it);
+            }
+            bp::tuple axes_tuple(axis_list);
+            projs.push_back(boost::shared_ptr<ndhist>(new ndhist(axes_tuple, self.bc_weight_dt_, self.bc_class_, self.is_profile())));
+
+            ndarray_storage & proj_bc = projs[p]->bc_;
+            projs_data[p] = proj_bc.get_data() + proj_bc.get_bytearray_data_offset() + proj_bc.calc_first_shape_element_data_offset();
+            projs_strides[p] = proj_bc.get_data_strides_vector();
+            projs_vtt.push_back(bin_vtt_t(proj_bc.construct_ndarray(proj_bc.get_dtype(), /*field_idx=*/0, /*data_owner=*/NULL, /*set_owndata_flag=*/false)));
+        }
+
+        // Iterate only once over *all* the bins (including underflow &
+        // overflow bins) of self and add each bin to the corresponding bin of
+        // every projection.
+        multi_axis_iter_t self_iter(self.bc_.construct_ndarray(self.bc_.get_dtype(), /*field_idx=*/0, /*data_owner=*/NULL, /*set_owndata_flag=*/false));
+        self_iter.init_full_iteration();
+        while(! self_iter.is_end())
+        {
+            typename multi_axis_iter_t::value_ref_type self_bin = self_iter.dereference();
+            std::vector<intptr_t> const & self_indices = self_iter.get_indices();
+
+            for(uintptr_t p=0; p<n_projs; ++p)
+            {
+                std::vector<intptr_t> const & proj_axes = projs_axes[p];
+                std::vector<intptr_t> const & proj_strides = projs_strides[p];
+                char * proj_bin_addr = projs_data[p];
+                for(uintptr_t i=0; i<proj_axes.size(); ++i)
+                {
+                    proj_bin_addr += self_indices[proj_axes[i]] * proj_strides[i];
+                }
+                typename bin_vtt_t::value_ref_type proj_bin = bin_vtt_t::dereference(projs_vtt[p], proj_bin_addr);
+
+                *proj_bin.noe_  += *self_bin.noe_;
+                *proj_bin.sow_  += *self_bin.sow_;
+                *proj_bin.sows_ += *self_bin.sows_;
+                if(is_profile)
+                {
+                    bin_utils<WeightValueType>::add_profile_sums(proj_bin_addr, self_iter.get_data(), po);
+                }
+            }
+
+            self_iter.increment();
+        }
+
+        return projs;
     }
 };
 
@@ -343,6 +576,8 @@ struct merge_axis_bins_fct_traits
         }
 
         bool const is_extendable_axis = self.axes_[axis]->is_extendable();
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
         intptr_t const rebinned_nbins = self_nbins / nbins_to_merge;
         intptr_t const offset = self.axes_[axis]->has_underflow_bin() ? 1 : 0;
         intptr_t const rebinned_end_idx = offset + rebinned_nbins;
@@ -360,6 +595,10 @@ struct merge_axis_bins_fct_traits
                 if(rebinned_idx != offset)
                 {
                     bin_utils<WeightValueType>::zero_bin(rebinned_iter.get_data());
+                    if(is_profile)
+                    {
+                        bin_utils<WeightValueType>::zero_profile_sums(rebinned_iter.get_data(), po);
+                    }
                 }
 
                 // Get the (zeroed) rebinned bin.
@@ -391,9 +630,16 @@ struct merge_axis_bins_fct_traits
                     *rebinned_bin.noe_  += *self_bin.noe_;
                     *rebinned_bin.sow_  += *self_bin.sow_;
                     *rebinned_bin.sows_ += *self_bin.sows_;
+                    if(is_profile)
+                    {
+                        bin_utils<WeightValueType>::add_profile_sums(rebinned_iter.get_data(), self_iter.get_data(), po);
+                    }
 
                     if(is_extendable_axis) {
                         bin_utils<WeightValueType>::zero_bin(self_iter.get_data());
+                        if(is_profile) {
+                            bin_utils<WeightValueType>::zero_profile_sums(self_iter.get_data(), po);
+                        }
                     }
 
                     self_iter.increment();
@@ -432,6 +678,10 @@ struct merge_axis_bins_fct_traits
             {
                 // Zero the current rebinned bin.
                 bin_utils<WeightValueType>::zero_bin(rebinned_iter.get_data());
+                if(is_profile)
+                {
+                    bin_utils<WeightValueType>::zero_profile_sums(rebinned_iter.get_data(), po);
+                }
 
                 // Get the zeroed rebinned bin.
                 typename multi_axis_iter_t::value_ref_type rebinned_bin = rebinned_iter.dereference();
@@ -457,9 +707,16 @@ struct merge_axis_bins_fct_traits
                     *rebinned_bin.noe_  += *self_bin.noe_;
                     *rebinned_bin.sow_  += *self_bin.sow_;
                     *rebinned_bin.sows_ += *self_bin.sows_;
+                    if(is_profile)
+                    {
+                        bin_utils<WeightValueType>::add_profile_sums(rebinned_iter.get_data(), self_iter.get_data(), po);
+                    }
 
                     if(is_extendable_axis) {
                         bin_utils<WeightValueType>::zero_bin(self_iter.get_data());
+                        if(is_profile) {
+                            bin_utils<WeightValueType>::zero_profile_sums(self_iter.get_data(), po);
+                        }
                     }
 
                     self_iter.increment();
@@ -486,6 +743,10 @@ struct merge_axis_bins_fct_traits
             while(! self_iter.is_end())
             {
                 bin_utils<WeightValueType>::zero_bin(self_iter.get_data());
+                if(is_profile)
+                {
+                    bin_utils<WeightValueType>::zero_profile_sums(self_iter.get_data(), po);
+                }
                 self_iter.increment();
             }
         }
@@ -506,7 +767,7 @@ struct merge_axis_bins_fct_traits
         bn::ndarray newedges = bn::empty(shape, self.axes_[axis]->get_dtype());
         typedef bn::iterators::flat_iterator< bn::iterators::single_value<WeightValueType> >
                 edges_iter_t;
-        edges_iter_t oldedges_iter(oldedges);
+        edges_iter_t oldedges_iter(oldedges, bn::detail::iter_operand::flags::READONLY::value);
         edges_iter_t newedges_iter(newedges);
         if(rebinned_axis_has_underflow_bin)
         {
@@ -548,35 +809,317 @@ struct merge_axis_bins_fct_traits
     }
 };
 
+/**
+ * Merges the bins of all axes at once. Instead of rebinning one axis after the
+ * other on a (deep) copy of the bin content array, a new compact bin content
+ * array is allocated for the rebinned shape, and each bin of self is added
+ * directly to its rebinned bin within a single pass over all the bins of self.
+ * The i-th element of nbins_to_merge specifies the number of bins to merge for
+ * the i-th axis. The bin content array and the axes of self are replaced by
+ * the rebinned ones.
+ * The arguments must have been validated already.
+ */
 template <typename WeightValueType>
-struct clear_fct_traits
+struct merge_bins_fct_traits
 {
     static
     void
-    apply(ndhist & self)
+    apply(ndhist & self, std::vector<intptr_t> const & nbins_to_merge)
     {
-        if(! self.is_view())
+        typedef bin_iter_value_type_traits<WeightValueType>
+                bin_vtt_t;
+        typedef multi_axis_iter<bin_vtt_t>
+                multi_axis_iter_t;
+
+        uintptr_t const nd = self.get_nd();
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
+        std::vector<intptr_t> const & self_shape = self.bc_.get_shape_vector();
+
+        // Calculate for each axis the mapping of the self bin indices
+        // (including the under- and overflow bins) to the rebinned bin
+        // indices, where -1 means that the self bin is discarded. In
+        // addition, collect the indices of the self bin edges, which are the
+        // bin edges of the rebinned axis.
+        std::vector< std::vector<intptr_t> > rebinned_indices(nd);
+        std::vector< std::vector<intptr_t> > rebinned_edge_indices(nd);
+        std::vector<bool> rebinned_axis_has_overflow_bin(nd);
+        std::vector<intptr_t> rebinned_shape(nd);
+        for(uintptr_t i=0; i<nd; ++i)
         {
-            // This ndhist object is not a view and the bin content array holds
-            // POD values, so we can just memset the entire bin content array.
-            self.bc_.clear();
-            return;
+            std::vector<intptr_t> & indices = rebinned_indices[i];
+            intptr_t const self_axis_shape = self_shape[i];
+            indices.resize(self_axis_shape);
+            if(nbins_to_merge[i] < 2)
+            {
+                for(intptr_t j=0; j<self_axis_shape; ++j)
+                {
+                    indices[j] = j;
+                }
+                rebinned_shape[i] = self_axis_shape;
+                continue;
+            }
+
+            // The underflow bin is kept as it is. The remaining bins, that do
+            // not fill up an entire rebinned bin, are merged together with a
+            // possible overflow bin into the (possibly new) overflow bin. But
+            // for an extendable axis they are discarded, because an
+            // extendable axis cannot hold an overflow bin.
+            Axis const & axis = *self.axes_[i];
+            intptr_t const m = nbins_to_merge[i];
+            intptr_t const offset = axis.has_underflow_bin() ? 1 : 0;
+            bool const self_axis_has_overflow_bin = axis.has_overflow_bin();
+            intptr_t const self_nbins = self_axis_shape - offset - self_axis_has_overflow_bin;
+            intptr_t const rebinned_nbins = self_nbins / m;
+            intptr_t const nbins_into_overflow = self_nbins % m;
+            rebinned_axis_has_overflow_bin[i] = (   !axis.is_extendable()
+                                                 && (self_axis_has_overflow_bin || nbins_into_overflow > 0)
+                                                );
+            intptr_t const rebinned_overflow_idx = (rebinned_axis_has_overflow_bin[i] ? offset + rebinned_nbins : -1);
+
+            if(offset)
+            {
+                indices[0] = 0;
+            }
+            for(intptr_t j=0; j<self_nbins; ++j)
+            {
+                intptr_t const k = j / m;
+                indices[offset + j] = (k < rebinned_nbins ? offset + k : rebinned_overflow_idx);
+            }
+            if(self_axis_has_overflow_bin)
+            {
+                indices[offset + self_nbins] = rebinned_overflow_idx;
+            }
+            rebinned_shape[i] = offset + rebinned_nbins + rebinned_axis_has_overflow_bin[i];
+
+            std::vector<intptr_t> & edge_indices = rebinned_edge_indices[i];
+            if(offset)
+            {
+                edge_indices.push_back(0);
+            }
+            for(intptr_t k=0; k<=rebinned_nbins; ++k)
+            {
+                edge_indices.push_back(offset + k*m);
+            }
+            if(rebinned_axis_has_overflow_bin[i])
+            {
+                edge_indices.push_back(self_axis_shape);
+            }
         }
 
-        // This ndhist object is a view on only a part of the bin content
-        // array, so we need to iterate over the view's bins and set them to
-        // zero.
-        typedef multi_axis_iter< bin_iter_value_type_traits<WeightValueType> >
+        // Create the new compact bin content array for the rebinned shape.
+        ndarray_storage rebinned_bc(self.bc_.get_dtype(), rebinned_shape, self.axes_extension_max_fcap_vec_, self.axes_extension_max_bcap_vec_);
+        char * const rebinned_data = rebinned_bc.get_data() + rebinned_bc.get_bytearray_data_offset() + rebinned_bc.calc_first_shape_element_data_offset();
+        std::vector<intptr_t> const & rebinned_strides = rebinned_bc.get_data_strides_vector();
+        bin_vtt_t rebinned_vtt(rebinned_bc.construct_ndarray(rebinned_bc.get_dtype(), /*field_idx=*/0, /*data_owner=*/NULL, /*set_owndata_flag=*/false));
+
+        // Convert the rebinned indices into byte offsets, so the address of
+        // the rebinned bin is just the sum of the per-axis byte offsets.
+        std::vector< std::vector<intptr_t> > rebinned_offsets(nd);
+        for(uintptr_t i=0; i<nd; ++i)
+        {
+            std::vector<intptr_t> const & indices = rebinned_indices[i];
+            rebinned_offsets[i].resize(indices.size());
+            for(size_t j=0; j<indices.size(); ++j)
+            {
+                rebinned_offsets[i][j] = (indices[j] < 0 ? -1 : indices[j] * rebinned_strides[i]);
+            }
+        }
+
+        // Iterate only once over *all* the bins (including underflow &
+        // overflow bins) of self and add each bin to its rebinned bin.
+        multi_axis_iter_t self_iter(self.bc_.construct_ndarray(self.bc_.get_dtype(), /*field_idx=*/0, /*data_owner=*/NULL, /*set_owndata_flag=*/false));
+        self_iter.init_full_iteration();
+        while(! self_iter.is_end())
+        {
+            std::vector<intptr_t> const & self_indices = self_iter.get_indices();
+
+            char * rebinned_bin_addr = rebinned_data;
+            bool is_discarded = false;
+            for(uintptr_t i=0; i<nd; ++i)
+            {
+                intptr_t const byte_offset = rebinned_offsets[i][self_indices[i]];
+                if(byte_offset < 0)
+                {
+                    is_discarded = true;
+                    break;
+                }
+                rebinned_bin_addr += byte_offset;
+            }
+
+            if(! is_discarded)
+            {
+                typename multi_axis_iter_t::value_ref_type self_bin = self_iter.dereference();
+                typename bin_vtt_t::value_ref_type rebinned_bin = bin_vtt_t::dereference(rebinned_vtt, rebinned_bin_addr);
+
+                *rebinned_bin.noe_  += *self_bin.noe_;
+                *rebinned_bin.sow_  += *self_bin.sow_;
+                *rebinned_bin.sows_ += *self_bin.sows_;
+                if(is_profile)
+                {
+                    bin_utils<WeightValueType>::add_profile_sums(rebinned_bin_addr, self_iter.get_data(), po);
+                }
+            }
+
+            self_iter.increment();
+        }
+
+        // Create new axis objects for the rebinned axes, using the
+        // corresponding self bin edges. The axis creation might fail (e.g.
+        // for a category axis), so the new axes are collected first and the
+        // axes and the bin content array of self are replaced together
+        // afterwards.
+        std::vector< boost::shared_ptr<Axis> > newaxes(self.axes_);
+        for(uintptr_t i=0; i<nd; ++i)
+        {
+            if(nbins_to_merge[i] < 2)
+            {
+                continue;
+            }
+            Axis const & oldaxis = *self.axes_[i];
+            bp::list edge_indices;
+            for(size_t j=0; j<rebinned_edge_indices[i].size(); ++j)
+            {
+                edge_indices.append(rebinned_edge_indices[i][j]);
+            }
+            bn::ndarray const newedges = bn::from_object(oldaxis.get_binedges_ndarray().attr("take")(edge_indices));
+            newaxes[i] = oldaxis.create(
+                newedges
+              , oldaxis.get_label()
+              , oldaxis.get_name()
+              , oldaxis.has_underflow_bin()
+              , rebinned_axis_has_overflow_bin[i]
+              , oldaxis.is_extendable()
+              , oldaxis.get_extension_max_fcap()
+              , oldaxis.get_extension_max_bcap()
+            );
+        }
+
+        self.axes_.swap(newaxes);
+        self.bc_ = rebinned_bc;
+    }
+};
+
+/**
+ * Returns the part of the given bin value, that corresponds to the fraction
+ * interval [frac_lo, frac_hi) of the bin. Integer values are split by
+ * cumulative rounding, so the parts of all the fraction intervals of a bin
+ * add up to the bin value again.
+ */
+template <typename ValueType>
+inline
+ValueType
+split_bin_value(ValueType const & value, double const frac_lo, double const frac_hi)
+{
+    if(frac_lo == 0 && frac_hi == 1)
+    {
+        return value;
+    }
+    if(std::numeric_limits<ValueType>::is_integer)
+    {
+        return ValueType(std::floor(double(value)*frac_hi + 0.5)) - ValueType(std::floor(double(value)*frac_lo + 0.5));
+    }
+    return ValueType(double(value)*(frac_hi - frac_lo));
+}
+
+/**
+ * Rebins the given axis of self onto the new bins described by the given
+ * overlap matrix. The overlap matrix is applied as a sparse matrix along the
+ * axis within a single pass over all the bins of self, i.e. each bin of self
+ * is added (or split) directly into the new bins of a new compact bin content
+ * array, which replaces the bin content array of self.
+ * The axis object itself is not changed.
+ */
+template <typename WeightValueType>
+struct rebin_axis_fct_traits
+{
+    static
+    void
+    apply(ndhist & self, intptr_t const axis, axis_overlap_matrix const & om)
+    {
+        typedef bin_iter_value_type_traits<WeightValueType>
+                bin_vtt_t;
+        typedef multi_axis_iter<bin_vtt_t>
                 multi_axis_iter_t;
 
+        uintptr_t const nd = self.get_nd();
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
+
+        // Create the new compact bin content array with the new number of
+        // bins for the axis.
+        std::vector<intptr_t> rebinned_shape = self.bc_.get_shape_vector();
+        rebinned_shape[axis] = om.get_n_bins();
+        ndarray_storage rebinned_bc(self.bc_.get_dtype(), rebinned_shape, self.axes_extension_max_fcap_vec_, self.axes_extension_max_bcap_vec_);
+        char * const rebinned_data = rebinned_bc.get_data() + rebinned_bc.get_bytearray_data_offset() + rebinned_bc.calc_first_shape_element_data_offset();
+        std::vector<intptr_t> const & rebinned_strides = rebinned_bc.get_data_strides_vector();
+        bin_vtt_t rebinned_vtt(rebinned_bc.construct_ndarray(rebinned_bc.get_dtype(), /*field_idx=*/0, /*data_owner=*/NULL, /*set_owndata_flag=*/false));
+
         multi_axis_iter_t self_iter(self.bc_.construct_ndarray(self.bc_.get_dtype(), /*field_idx=*/0, /*data_owner=*/NULL, /*set_owndata_flag=*/false));
         self_iter.init_full_iteration();
         while(! self_iter.is_end())
         {
-            bin_utils<WeightValueType>::zero_bin(self_iter.get_data());
+            std::vector<intptr_t> const & self_indices = self_iter.get_indices();
+
+            // Calculate the address of the rebinned bin with index 0 for the
+            // axis.
+            char * rebinned_row_addr = rebinned_data;
+            for(uintptr_t i=0; i<nd; ++i)
+            {
+                if(i != uintptr_t(axis))
+                {
+                    rebinned_row_addr += self_indices[i] * rebinned_strides[i];
+                }
+            }
+
+            typename multi_axis_iter_t::value_ref_type self_bin = self_iter.dereference();
+            char * const self_bin_addr = self_iter.get_data();
+            intptr_t const row_end = om.get_row_end(self_indices[axis]);
+            for(intptr_t e=om.get_row_begin(self_indices[axis]); e<row_end; ++e)
+            {
+                char * const rebinned_bin_addr = rebinned_row_addr + om.get_new_idx(e) * rebinned_strides[axis];
+                typename bin_vtt_t::value_ref_type rebinned_bin = bin_vtt_t::dereference(rebinned_vtt, rebinned_bin_addr);
+
+                double const frac_lo = om.get_frac_lo(e);
+                double const frac_hi = om.get_frac_hi(e);
+                *rebinned_bin.noe_  += split_bin_value<uintptr_t>(*self_bin.noe_, frac_lo, frac_hi);
+                *rebinned_bin.sow_  += split_bin_value<WeightValueType>(*self_bin.sow_, frac_lo, frac_hi);
+                *rebinned_bin.sows_ += split_bin_value<WeightValueType>(*self_bin.sows_, frac_lo, frac_hi);
+                if(is_profile)
+                {
+                    WeightValueType const & self_sowy  = *reinterpret_cast<WeightValueType const *>(self_bin_addr + po.sowy_);
+                    WeightValueType const & self_sowyy = *reinterpret_cast<WeightValueType const *>(self_bin_addr + po.sowyy_);
+                    *reinterpret_cast<WeightValueType *>(rebinned_bin_addr + po.sowy_)  += split_bin_value<WeightValueType>(self_sowy, frac_lo, frac_hi);
+                    *reinterpret_cast<WeightValueType *>(rebinned_bin_addr + po.sowyy_) += split_bin_value<WeightValueType>(self_sowyy, frac_lo, frac_hi);
+                }
+            }
 
             self_iter.increment();
         }
+
+        self.bc_ = rebinned_bc;
+    }
+};
+
+template <typename WeightValueType>
+struct clear_fct_traits
+{
+    static
+    void
+    apply(ndhist & self)
+    {
+        if(! self.is_view())
+        {
+            // This ndhist object is not a view and the bin content array holds
+            // POD values, so we can just memset the entire bin content array.
+            self.bc_.clear();
+            return;
+        }
+
+        // This ndhist object is a view on only a part of the bin content
+        // array, so we need to set only the view's bins to zero. The bins
+        // hold POD values, so the contiguous blocks of bins can be memset.
+        self.bc_.clear_view();
     }
 };
 
@@ -606,16 +1149,100 @@ struct clear_fct_traits<bp::object>
 };
 
 template <typename WeightValueType>
-struct get_binerror_ndarray_fct_traits
+struct get_axis_cumsow_fct_traits
 {
     static
-    bn::ndarray
-    apply(ndhist const & self)
+    void
+    apply(ndhist const & proj, std::vector<double> & cumsow)
     {
-        // The core part of the bin content array excludes the under- and
-        // overflow bins. So we need to create an appropriate view into the bin
-        // content array.
-        std::vector<intptr_t> shape;
+        // The given ndhist object is 1-dimensional. Iterate over its bins and
+        // exclude possible under- and overflow bins.
+        Axis const & theaxis = *proj.axes_[0];
+        intptr_t nbins = theaxis.get_n_bins();
+        if(theaxis.has_underflow_bin()) --nbins;
+        if(theaxis.has_overflow_bin()) --nbins;
+
+        typedef bn::iterators::flat_iterator< bin_iter_value_type_traits<WeightValueType> >
+                bin_iter_t;
+        bin_iter_t bin_iter(proj.bc_.construct_ndarray(proj.bc_.get_dtype(), /*field_idx=*/0, /*data_owner=*/NULL, /*set_owndata_flag=*/false), bn::detail::iter_operand::flags::READONLY::value);
+
+        // Skip the underflow bin.
+        if(theaxis.has_underflow_bin()) ++bin_iter;
+
+        cumsow.resize(nbins);
+        double sow_sum = 0;
+        for(intptr_t i=0; i<nbins; ++i)
+        {
+            typename bin_iter_t::value_ref_type bin = *bin_iter;
+            sow_sum += *bin.sow_;
+            cumsow[i] = sow_sum;
+            ++bin_iter;
+        }
+    }
+};
+
+template <>
+struct get_axis_cumsow_fct_traits<bp::object>
+{
+    static
+    void
+    apply(ndhist const &, std::vector<double> &)
+    {
+        std::stringstream ss;
+        ss << "The cumulative sum of weights is only defined for POD weight "
+           << "types!";
+        throw TypeError(ss.str());
+    }
+};
+
+template <typename WeightValueType>
+struct fill_summed_area_table_fct_traits
+{
+    static
+    void
+    apply(ndhist const & self, summed_area_table & sat)
+    {
+        typedef multi_axis_iter< bin_iter_value_type_traits<WeightValueType> >
+                multi_axis_iter_t;
+
+        // Copy all the bins (including the under- and overflow bins) into the
+        // table and turn them into the prefix sums afterwards.
+        multi_axis_iter_t self_iter(self.bc_.construct_ndarray(self.bc_.get_dtype(), /*field_idx=*/0, /*data_owner=*/NULL, /*set_owndata_flag=*/false));
+        self_iter.init_full_iteration();
+        while(! self_iter.is_end())
+        {
+            typename multi_axis_iter_t::value_ref_type self_bin = self_iter.dereference();
+            sat.set_bin(self_iter.get_indices(), double(*self_bin.noe_), double(*self_bin.sow_), double(*self_bin.sows_));
+            self_iter.increment();
+        }
+        sat.scan();
+    }
+};
+
+template <>
+struct fill_summed_area_table_fct_traits<bp::object>
+{
+    static
+    void
+    apply(ndhist const &, summed_area_table &)
+    {
+        std::stringstream ss;
+        ss << "The summed-area table is only defined for POD weight types!";
+        throw TypeError(ss.str());
+    }
+};
+
+template <typename WeightValueType>
+struct get_binerror_ndarray_fct_traits
+{
+    static
+    bn::ndarray
+    apply(ndhist const & self)
+    {
+        // The core part of the bin content array excludes the under- and
+        // overflow bins. So we need to create an appropriate view into the bin
+        // content array.
+        std::vector<intptr_t> shape;
         std::vector<intptr_t> front_capacity;
         std::vector<intptr_t> back_capacity;
         self.calc_core_bin_content_ndarray_settings(shape, front_capacity, back_capacity);
@@ -676,6 +1303,89 @@ struct get_binerror_ndarray_fct_traits<bp::object>
     }
 };
 
+template <typename WeightValueType>
+struct get_profile_ndarray_fct_traits
+{
+    static
+    bn::ndarray
+    apply(ndhist const & self, bool const calc_std)
+    {
+        if(! self.is_profile())
+        {
+            std::stringstream ss;
+            ss << "This ndhist object is not a profile histogram!";
+            throw TypeError(ss.str());
+        }
+
+        // The core part of the bin content array excludes the under- and
+        // overflow bins. So we need to create an appropriate view into the bin
+        // content array.
+        std::vector<intptr_t> shape;
+        std::vector<intptr_t> front_capacity;
+        std::vector<intptr_t> back_capacity;
+        self.calc_core_bin_content_ndarray_settings(shape, front_capacity, back_capacity);
+
+        bn::ndarray bc_arr = detail::ndarray_storage::construct_ndarray(self.bc_, self.bc_.get_dtype(), shape, front_capacity, back_capacity, /*sub_item_byte_offset=*/0, /*owner=*/NULL, /*set_owndata_flag=*/false);
+        bn::ndarray out = bn::empty(shape, bn::dtype::get_builtin<double>());
+
+        typedef bn::iterators::multi_flat_iterator<2>::impl<
+                    bin_iter_value_type_traits<WeightValueType>
+                  , bn::iterators::single_value<double>
+                >
+                multi_iter_t;
+        multi_iter_t it(
+            bc_arr
+          , out
+          , boost::numpy::detail::iter_operand::flags::READONLY::value
+          , boost::numpy::detail::iter_operand::flags::WRITEONLY::value
+        );
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
+        while(! it.is_end())
+        {
+            typename multi_iter_t::multi_references_type multi_value = *it;
+            typename multi_iter_t::value_ref_type_0 bin = multi_value.value_0;
+
+            double const sow = *bin.sow_;
+            if(sow == 0)
+            {
+                it.set_value_1(std::numeric_limits<double>::quiet_NaN());
+            }
+            else
+            {
+                // The noe_ pointer points to the beginning of the bin.
+                char * const bin_addr = reinterpret_cast<char*>(bin.noe_);
+                double const mean = *reinterpret_cast<WeightValueType*>(bin_addr + po.sowy_) / sow;
+                if(calc_std)
+                {
+                    double const var = *reinterpret_cast<WeightValueType*>(bin_addr + po.sowyy_) / sow - mean*mean;
+                    it.set_value_1(std::sqrt(std::max(var, 0.)));
+                }
+                else
+                {
+                    it.set_value_1(mean);
+                }
+            }
+            ++it;
+        }
+
+        return out;
+    }
+};
+
+template <>
+struct get_profile_ndarray_fct_traits<bp::object>
+{
+    static
+    bn::ndarray
+    apply(ndhist const &, bool const)
+    {
+        std::stringstream ss;
+        ss << "Profile histograms are not supported for the object weight "
+           << "type!";
+        throw TypeError(ss.str());
+    }
+};
+
 /**
  * @brief Creates a ND-sized vector of ndarray objects which are views into the
  *     complete (i.e. including under- and overflow bins) bin content array.
@@ -812,40 +1522,191 @@ struct get_ndvalue_ptr_traits<false>
 };
 
 
-template <typename BCValueType, bool UseSpecificNDTraits>
-struct get_weight_value_ref_traits;
+template <bool UseSpecificNDTraits>
+struct get_weight_ptr_traits;
 
-template <typename BCValueType>
-struct get_weight_value_ref_traits<BCValueType, true>
+template <>
+struct get_weight_ptr_traits<true>
 {
     static
-    typename bin_utils<BCValueType>::weight_ref_type
+    char *
     apply(
         bn::detail::iter & iter
       , size_t nd
     )
     {
-        return bin_utils<BCValueType>::get_weight_type_value_from_iter(iter, nd);
+        return iter.get_data(nd);
     }
 };
 
-template <typename BCValueType>
-struct get_weight_value_ref_traits<BCValueType, false>
+template <>
+struct get_weight_ptr_traits<false>
 {
     static
-    typename bin_utils<BCValueType>::weight_ref_type
+    char *
     apply(
         bn::detail::iter & iter
       , size_t
     )
     {
-        return bin_utils<BCValueType>::get_weight_type_value_from_iter(iter, 1);
+        return iter.get_data(1);
     }
 };
 
+/**
+ * Increments the bin at the given address with the given weight. For float64
+ * weights and an enabled shadow accumulation, the shadow record of the bin is
+ * incremented instead.
+ */
+template <typename BCValueType>
+struct shadow_accumulation_traits
+{
+    static
+    void
+    increment_bin(
+        shadow_accumulator * const
+      , char * const bc_data_addr
+      , char * const
+      , intptr_t const
+      , typename bin_utils<BCValueType>::weight_ref_type weight
+    )
+    {
+        bin_utils<BCValueType>::increment_bin(bc_data_addr, weight);
+    }
+};
+
+template <>
+struct shadow_accumulation_traits<double>
+{
+    static
+    void
+    increment_bin(
+        shadow_accumulator * const shadow
+      , char * const bc_data_addr
+      , char * const bc_data
+      , intptr_t const itemsize
+      , bin_utils<double>::weight_ref_type weight
+    )
+    {
+        if(shadow == NULL)
+        {
+            bin_utils<double>::increment_bin(bc_data_addr, weight);
+            return;
+        }
+        shadow->increment(bc_data, itemsize, (bc_data_addr - bc_data)/itemsize, weight);
+    }
+};
+
+/**
+ * The shadow_accumulation_guard class sets up the shadow accumulator of the
+ * given ndhist object for a fill, if the shadow accumulation is enabled, and
+ * makes sure, that it is flushed when the fill ends, even by an exception.
+ */
+class shadow_accumulation_guard
+{
+  public:
+    shadow_accumulation_guard(ndhist & self)
+      : self_(self)
+      , shadow_(NULL)
+    {
+        if(self_.shadow_accumulation_)
+        {
+            if(! self_.shadow_accumulator_)
+            {
+                self_.shadow_accumulator_ = boost::shared_ptr<shadow_accumulator>(new shadow_accumulator(get_n_bc_records()));
+            }
+            else if(self_.shadow_accumulator_->get_n_records() != get_n_bc_records())
+            {
+                self_.shadow_accumulator_->resize(get_n_bc_records());
+            }
+            shadow_ = self_.shadow_accumulator_.get();
+        }
+    }
+
+    ~shadow_accumulation_guard()
+    {
+        flush();
+    }
+
+    inline
+    shadow_accumulator *
+    get() const
+    {
+        return shadow_;
+    }
+
+    inline
+    void
+    flush()
+    {
+        if(shadow_)
+        {
+            shadow_->flush(self_.bc_.get_data(), self_.bc_.get_dtype().get_itemsize());
+        }
+    }
+
+    /**
+     * @brief Resizes the (flushed) shadow accumulator to the bin content array
+     *     after the bin content array has been extended.
+     */
+    inline
+    void
+    resize()
+    {
+        if(shadow_ && shadow_->get_n_records() != get_n_bc_records())
+        {
+            shadow_->resize(get_n_bc_records());
+        }
+    }
+
+  protected:
+    inline
+    intptr_t
+    get_n_bc_records() const
+    {
+        return self_.bc_.bytearray_->bytesize_ / self_.bc_.get_dtype().get_itemsize();
+    }
+
+    ndhist & self_;
+    shadow_accumulator * shadow_;
+};
+
 template <typename BCValueType, bool UseSpecificNDTraits>
 struct fill_impl
 {
+    /**
+     * Searches the bin indices of the m values starting at the value k0 of
+     * the current chunk for all axes. A single value is searched through the
+     * scalar bin search of the axis.
+     */
+    static
+    void
+    search_bins(
+        std::vector<Axis const *> const & axis_bases
+      , std::vector<Axis::get_bin_index_fct_t> const & get_bin_index_fcts
+      , std::vector<Axis::get_bin_indices_fct_t> const & get_bin_indices_fcts
+      , std::vector<char *> const & value_ptrs
+      , std::vector<intptr_t> const & value_strides
+      , intptr_t const chunk_capacity
+      , intptr_t const k0
+      , intptr_t const m
+      , std::vector<intptr_t> & chunk_bin_indices
+      , std::vector< ::ndhist::axis::out_of_range_t > & chunk_oor_flags
+    )
+    {
+        size_t const nd = axis_bases.size();
+        for(size_t i=0; i<nd; ++i)
+        {
+            intptr_t const idx0 = intptr_t(i)*chunk_capacity + k0;
+            if(m == 1)
+            {
+                chunk_bin_indices[idx0] = get_bin_index_fcts[i](*axis_bases[i], value_ptrs[idx0], chunk_oor_flags[idx0]);
+                continue;
+            }
+            get_bin_indices_fcts[i](*axis_bases[i], value_ptrs[idx0], value_strides[i], m, &chunk_bin_indices[idx0], &chunk_oor_flags[idx0]);
+        }
+    }
+
     static
     void
     apply(
@@ -856,9 +1717,23 @@ struct fill_impl
     {
         size_t const nd = self.get_nd();
 
+        // For a profile histogram, the profile value is given as an extra
+        // value column right after the axis value columns.
+        bool const is_profile = self.is_profile();
+        profile_sums_offsets const po = self.get_profile_sums_offsets();
+        size_t const n_fill_columns = self.get_n_fill_columns();
+        BCValueType y = BCValueType();
+
+        bool const track_unbinned_moments = self.is_tracking_unbinned_moments();
+
         // Get a handle on the value cache.
         ValueCache<BCValueType> & value_cache = self.get_value_cache<BCValueType>();
 
+        // Set up the shadow accumulator, if enabled.
+        shadow_accumulation_guard shadow_guard(self);
+        shadow_accumulator * const shadow = shadow_guard.get();
+        intptr_t const bc_itemsize = self.bc_.get_dtype().get_itemsize();
+
         // Do the iteration.
         std::vector<intptr_t> indices(nd, 0);
         std::vector<intptr_t> relative_indices(nd, 0);
@@ -866,8 +1741,39 @@ struct fill_impl
         std::vector<intptr_t> b_n_extra_bins_vec(nd, 0);
         std::vector<intptr_t> const & bc_fcap = self.bc_.get_front_capacity_vector();
         std::vector<intptr_t> const & bc_bcap = self.bc_.get_back_capacity_vector();
+
+        // Resolve the (unwrapped) axis objects and their scalar and batched
+        // bin search functions once, so the bin search of a chunk of values
+        // is a direct function call. Axes without a native batched bin search
+        // fall back to calling their scalar bin search for each value.
+        std::vector<Axis const *> axis_bases(nd, NULL);
+        std::vector<Axis::get_bin_index_fct_t> get_bin_index_fcts(nd, NULL);
+        std::vector<Axis::get_bin_indices_fct_t> get_bin_indices_fcts(nd, NULL);
+        for(size_t i=0; i<nd; ++i)
+        {
+            axis_bases[i] = &self.axes_[i]->get_axis_base();
+            get_bin_index_fcts[i] = self.axes_[i]->get_bin_index_fct();
+            get_bin_indices_fcts[i] = self.axes_[i]->get_bin_indices_fct();
+            if(get_bin_indices_fcts[i] == NULL)
+            {
+                get_bin_indices_fcts[i] = &Axis::get_bin_indices_by_value;
+            }
+        }
+
+        // The data pointers of the values of the current chunk, and their bin
+        // indices and out-of-range flags for each axis. The entries of axis i
+        // start at the index i*chunk_capacity.
+        intptr_t const chunk_capacity = NDHIST_LIMIT_FILL_BIN_SEARCH_CHUNK_SIZE;
+        std::vector<char *> value_ptrs(nd*chunk_capacity, NULL);
+        std::vector<intptr_t> value_strides(nd, 0);
+        std::vector<char *> weight_ptrs(chunk_capacity, NULL);
+        std::vector<char *> y_ptrs(chunk_capacity, NULL);
+        std::vector<intptr_t> chunk_bin_indices(nd*chunk_capacity, 0);
+        std::vector< ::ndhist::axis::out_of_range_t > chunk_oor_flags(nd*chunk_capacity, ::ndhist::axis::OOR_NONE);
+
         bool is_oor;
         bool extend_axes;
+        bool axes_extended;
         bool reallocation_upon_extension = false;
         bool value_cached;
         ::ndhist::axis::out_of_range_t oor_flag;
@@ -875,48 +1781,98 @@ struct fill_impl
         char * bc_data_addr;
         do {
             intptr_t size = iter.get_inner_loop_size();
-            while(size--)
+            while(size > 0)
             {
-                // Get the weight scalar from the iterator.
-                typename bin_utils<BCValueType>::weight_ref_type weight = get_weight_value_ref_traits<BCValueType, UseSpecificNDTraits>::apply(iter, nd);
+                intptr_t const m = std::min(size, chunk_capacity);
+                size -= m;
 
-                // Fill the scalar ndvalue into the bin content array.
-                // Get the coordinate of the current ndvalue.
-                is_oor = false;
-                extend_axes = false;
-                value_cached = false;
-
-                std::vector<intptr_t> const & bc_data_strides = self.bc_.get_data_strides_vector();
-                bc_data_addr = self.bc_.get_data() + bc_data_offset;
+                // Collect the data pointers of the next chunk of values of the
+                // inner loop. The data of the inner loop stays valid until the
+                // iterator moves to the next inner loop.
+                for(intptr_t k=0; k<m; ++k)
+                {
+                    for(size_t i=0; i<nd; ++i)
+                    {
+                        value_ptrs[i*chunk_capacity + k] = get_ndvalue_ptr_traits<UseSpecificNDTraits>::apply(iter, ndvalue_byte_offsets, i);
+                    }
+                    weight_ptrs[k] = get_weight_ptr_traits<UseSpecificNDTraits>::apply(iter, n_fill_columns);
+                    if(is_profile)
+                    {
+                        y_ptrs[k] = get_ndvalue_ptr_traits<UseSpecificNDTraits>::apply(iter, ndvalue_byte_offsets, nd);
+                    }
+                    iter.add_inner_loop_strides_to_data_ptrs();
+                }
+                // The stride of the values within an inner loop is constant.
                 for(size_t i=0; i<nd; ++i)
                 {
-                    // Don't waste time for values, which can't be filled
-                    // anyways.
-                    if(is_oor) break;
-
-                    //std::cout << "tuple fill: Get bin idx of axis " << i << " of " << ND << std::endl;
-                    Axis & axis = *self.axes_[i];
-                    char * const ndvalue_ptr = get_ndvalue_ptr_traits<UseSpecificNDTraits>::apply(iter, ndvalue_byte_offsets, i);
-                    intptr_t const bin_idx = axis.get_bin_index(ndvalue_ptr, oor_flag);
-                    //std::cout << "bin_idx = "<<bin_idx<<std::endl;
-                    if(oor_flag == ::ndhist::axis::OOR_NONE)
+                    value_strides[i] = (m > 1 ? value_ptrs[i*chunk_capacity + 1] - value_ptrs[i*chunk_capacity] : 0);
+                }
+
+                // Search the bins of all the values of the chunk, axis by
+                // axis.
+                search_bins(axis_bases, get_bin_index_fcts, get_bin_indices_fcts, value_ptrs, value_strides, chunk_capacity, 0, m, chunk_bin_indices, chunk_oor_flags);
+
+                for(intptr_t k=0; k<m; ++k)
+                {
+                    // Check if the ndvalue is out-of-range on at least one
+                    // axis, which is not extendable. There is no way to fill
+                    // such an ndvalue, so just skip it. This must be done
+                    // before any extendable axis is asked for an extension,
+                    // so a skipped ndvalue does not extend any axis (e.g. by
+                    // a new category).
+                    is_oor = false;
+                    for(size_t i=0; i<nd; ++i)
                     {
-                        // The current value fits into the current axis
-                        // range.
-                        //std::cout << "normal fill i=" << i << "indices.size()="<<indices.size();
-                        //std::cout << "relative_indices.size() "<< relative_indices.size()<<std::endl;
-                        bc_data_addr += bin_idx*bc_data_strides[i];
-
-                        indices[i] = bin_idx;
-                        relative_indices[i] = bin_idx;
+                        if(   chunk_oor_flags[i*chunk_capacity + k] != ::ndhist::axis::OOR_NONE
+                           && ! self.axes_[i]->is_extendable()
+                          )
+                        {
+                            is_oor = true;
+                            break;
+                        }
+                    }
+                    if(is_oor)
+                    {
+                        continue;
                     }
-                    else
+
+                    // Get the weight scalar.
+                    typename bin_utils<BCValueType>::weight_ref_type weight = bin_utils<BCValueType>::get_weight_type_value_from_ptr(weight_ptrs[k]);
+
+                    // Get the profile value.
+                    if(is_profile)
                     {
-                        // The current value does not fit into the current
-                        // axis range. But the axis might be extendable.
-                        if(axis.is_extendable())
+                        y = bin_utils<BCValueType>::get_weight_type_value_from_ptr(y_ptrs[k]);
+                    }
+
+                    // Fill the scalar ndvalue into the bin content array.
+                    // Get the coordinate of the current ndvalue.
+                    extend_axes = false;
+                    axes_extended = false;
+                    value_cached = false;
+
+                    std::vector<intptr_t> const & bc_data_strides = self.bc_.get_data_strides_vector();
+                    bc_data_addr = self.bc_.get_data() + bc_data_offset;
+                    for(size_t i=0; i<nd; ++i)
+                    {
+                        Axis & axis = *self.axes_[i];
+                        char * const ndvalue_ptr = value_ptrs[i*chunk_capacity + k];
+                        intptr_t const bin_idx = chunk_bin_indices[i*chunk_capacity + k];
+                        oor_flag = chunk_oor_flags[i*chunk_capacity + k];
+                        if(oor_flag == ::ndhist::axis::OOR_NONE)
+                        {
+                            // The current value fits into the current axis
+                            // range.
+                            bc_data_addr += bin_idx*bc_data_strides[i];
+
+                            indices[i] = bin_idx;
+                            relative_indices[i] = bin_idx;
+                        }
+                        else
                         {
-                            //std::cout << "axis is extentable" << std::endl;
+                            // The current value does not fit into the current
+                            // axis range. But the axis is extendable (see the
+                            // check above), so request an extension for it.
                             intptr_t const n_extra_bins = axis.request_extension(ndvalue_ptr, oor_flag);
                             if(oor_flag == ::ndhist::axis::OOR_UNDERFLOW)
                             {
@@ -939,93 +1895,106 @@ struct fill_impl
 
                             extend_axes = true;
                         }
-                        else
+                    }
+
+                    // Accumulate the unbinned moments of the axis values of
+                    // the ndvalue, that will be filled (now or from the value
+                    // cache).
+                    if(track_unbinned_moments)
+                    {
+                        double const w = weight_to_double<BCValueType>::apply(weight);
+                        for(size_t i=0; i<nd; ++i)
                         {
-                            //std::cout << "axis is NOT extendable" << std::endl;
-                            // The current value is out-of-range on the
-                            // current axis, which is not extendable.
-                            // So mark this ndvalue as oor.
-                            is_oor = true;
+                            self.unbinned_moments_[i].add(self.axis_value_to_double_fcts_[i](value_ptrs[i*chunk_capacity + k]), w);
                         }
                     }
-                }
 
-                if(is_oor)
-                {
-                    // There is at least one axis, where the value is
-                    // out-of-range, so there is no way to fill this
-                    // ndvalue. So just skip it.
-                    continue;
-                }
-
-                // If the value can be filled but an axis needs to get
-                // extended in order to do so, we want to cache the value if
-                // the extension would trigger a reallocation of memory.
-                if(extend_axes)
-                {
-                    //std::cout << "extend_axes is true, size="<< oorfrstack.get_size() << std::endl<<std::flush;
-                    // Check if an actual reallocation is required,
-                    // if not, just extend the axes and fill it. Otherwise,
-                    // fill the value into the value cache.
-                    if(reallocation_upon_extension)
+                    // If the value can be filled but an axis needs to get
+                    // extended in order to do so, we want to cache the value
+                    // if the extension would trigger a reallocation of memory.
+                    if(extend_axes)
                     {
-                        //std::cout << "reallocation required upon extension " << std::endl<<std::flush;
-                        // Push the value into the value cache stack.
-                        // If it returns ``true`` the cache is full and we
-                        // need to extent the axes and fill the cached
-                        // values in.
-                        value_cached = true;
-                        if(value_cache.push_back(relative_indices, weight))
+                        // Check if an actual reallocation is required,
+                        // if not, just extend the axes and fill it. Otherwise,
+                        // fill the value into the value cache.
+                        if(reallocation_upon_extension)
+                        {
+                            // Push the value into the value cache stack.
+                            // If it returns ``true`` the cache is full and we
+                            // need to extent the axes and fill the cached
+                            // values in.
+                            value_cached = true;
+                            if(value_cache.push_back(relative_indices, weight, y))
+                            {
+                                shadow_guard.flush();
+                                self.extend_axes(f_n_extra_bins_vec, b_n_extra_bins_vec);
+                                self.extend_bin_content_array(f_n_extra_bins_vec, b_n_extra_bins_vec);
+                                shadow_guard.resize();
+                                bc_data_offset = self.bc_.get_bytearray_data_offset() + self.bc_.calc_first_shape_element_data_offset();
+
+                                flush_value_cache<BCValueType>(self, value_cache, f_n_extra_bins_vec, bc_data_offset);
+
+                                memset(&f_n_extra_bins_vec.front(), 0, nd*sizeof(intptr_t));
+                                memset(&b_n_extra_bins_vec.front(), 0, nd*sizeof(intptr_t));
+                                reallocation_upon_extension = false;
+                                axes_extended = true;
+                            }
+                        }
+                        else
                         {
-                            //std::cout << "The stack is full. Flush it." << std::endl<<std::flush;
+                            // No reallocation of memory is required for the
+                            // extension, so we just extend the axes.
+                            shadow_guard.flush();
                             self.extend_axes(f_n_extra_bins_vec, b_n_extra_bins_vec);
                             self.extend_bin_content_array(f_n_extra_bins_vec, b_n_extra_bins_vec);
+                            shadow_guard.resize();
                             bc_data_offset = self.bc_.get_bytearray_data_offset() + self.bc_.calc_first_shape_element_data_offset();
-
-                            flush_value_cache<BCValueType>(self, value_cache, f_n_extra_bins_vec, bc_data_offset);
-
                             memset(&f_n_extra_bins_vec.front(), 0, nd*sizeof(intptr_t));
                             memset(&b_n_extra_bins_vec.front(), 0, nd*sizeof(intptr_t));
-                            reallocation_upon_extension = false;
+                            axes_extended = true;
+
+                            // Since the strides have changed, we need to
+                            // recompute the bc_data_addr.
+                            std::vector<intptr_t> const & bc_data_strides = self.bc_.get_data_strides_vector();
+                            bc_data_addr = self.bc_.get_data() + bc_data_offset;
+                            for(size_t i=0; i<nd; ++i)
+                            {
+                                bc_data_addr += indices[i]*bc_data_strides[i];
+                            }
                         }
                     }
-                    else
+                    if(! value_cached)
                     {
-                        // No reallocation of memory is required for the
-                        // extension, so we just extend the axes.
-                        //std::cout << "no reallocation required upon extension " << std::endl<<std::flush;
-                        self.extend_axes(f_n_extra_bins_vec, b_n_extra_bins_vec);
-                        self.extend_bin_content_array(f_n_extra_bins_vec, b_n_extra_bins_vec);
-                        bc_data_offset = self.bc_.get_bytearray_data_offset() + self.bc_.calc_first_shape_element_data_offset();
-                        memset(&f_n_extra_bins_vec.front(), 0, nd*sizeof(intptr_t));
-                        memset(&b_n_extra_bins_vec.front(), 0, nd*sizeof(intptr_t));
-
-                        // Since the strides have changed, we need to
-                        // recompute the bc_data_addr.
-                        std::vector<intptr_t> const & bc_data_strides = self.bc_.get_data_strides_vector();
-                        bc_data_addr = self.bc_.get_data() + bc_data_offset;
-                        for(size_t i=0; i<nd; ++i)
+                        if(is_profile)
                         {
-                            bc_data_addr += indices[i]*bc_data_strides[i];
+                            detail::bin_utils<BCValueType>::increment_profile_bin(bc_data_addr, weight, y, po);
+                        }
+                        else
+                        {
+                            shadow_accumulation_traits<BCValueType>::increment_bin(shadow, bc_data_addr, self.bc_.get_data(), bc_itemsize, weight);
                         }
                     }
-                }
-                if(! value_cached)
-                {
-                    //std::cout << "increment the bin "<< std::endl<<std::flush;
-                    detail::bin_utils<BCValueType>::increment_bin(bc_data_addr, weight);
-                }
 
-                // Jump to the next fill iteration.
-                iter.add_inner_loop_strides_to_data_ptrs();
+                    // The bin indices of the remaining values of the chunk
+                    // have been searched on the axes before their extension,
+                    // so search them again.
+                    if(axes_extended && k+1 < m)
+                    {
+                        search_bins(axis_bases, get_bin_index_fcts, get_bin_indices_fcts, value_ptrs, value_strides, chunk_capacity, k+1, m-k-1, chunk_bin_indices, chunk_oor_flags);
+                    }
+                }
             }
         } while(iter.next());
 
+        // Add the shadow accumulator to the bin content array.
+        shadow_guard.flush();
+
         // Fill the remaining cached values.
         if(value_cache.get_size() > 0)
         {
             self.extend_axes(f_n_extra_bins_vec, b_n_extra_bins_vec);
             self.extend_bin_content_array(f_n_extra_bins_vec, b_n_extra_bins_vec);
+            shadow_guard.resize();
             bc_data_offset = self.bc_.get_bytearray_data_offset() + self.bc_.calc_first_shape_element_data_offset();
 
             flush_value_cache<BCValueType>(self, value_cache, f_n_extra_bins_vec, bc_data_offset);
@@ -1033,6 +2002,90 @@ struct fill_impl
     }
 };
 
+/**
+ * Fills the given input objects in chunks of at most
+ * NDHIST_LIMIT_FILL_CONVERSION_CHUNK_SIZE values, if at least one of them is a
+ * one-dimensional ndarray with a data type different from its given fill data
+ * type. Otherwise the fill function would convert all the values of such an
+ * input at once into a temporary array, which doubles the memory usage for
+ * large inputs. By filling in chunks, only the values of one chunk are
+ * converted at a time. The last input object is the weight object. Inputs,
+ * which are scalars, are passed unchanged to each chunk. If pack_values_into_tuple
+ * is set to true, the chunks of the value inputs are passed as a tuple to the
+ * fill function, otherwise the chunk of the only value input is passed.
+ * It returns ``false`` if the inputs are not suitable for chunked filling, and
+ * nothing has been filled.
+ */
+static
+bool
+fill_in_conversion_chunks(
+    ndhist & self
+  , std::vector<bp::object> const & objs
+  , std::vector<bn::dtype> const & dts
+  , bool const pack_values_into_tuple
+  , void (*fill_fct)(ndhist &, bp::object const &, bp::object const &)
+)
+{
+    intptr_t const chunk_size = NDHIST_LIMIT_FILL_CONVERSION_CHUNK_SIZE;
+    size_t const n_objs = objs.size();
+    std::vector<bool> is_scalar(n_objs, false);
+    intptr_t n_values = -1;
+    bool needs_conversion = false;
+    for(size_t i=0; i<n_objs; ++i)
+    {
+        if(! bn::is_ndarray(objs[i]))
+        {
+            if(bn::is_any_scalar(objs[i]))
+            {
+                is_scalar[i] = true;
+                continue;
+            }
+            // Lists and other sequences get converted entirely anyways.
+            return false;
+        }
+        bn::ndarray const arr = *static_cast<bn::ndarray const *>(&objs[i]);
+        if(arr.get_nd() == 0)
+        {
+            is_scalar[i] = true;
+            continue;
+        }
+        if(arr.get_nd() != 1 || (n_values >= 0 && arr.shape(0) != n_values))
+        {
+            return false;
+        }
+        n_values = arr.shape(0);
+        if(! bn::dtype::equivalent(arr.get_dtype(), dts[i]))
+        {
+            needs_conversion = true;
+        }
+    }
+    if(! needs_conversion || n_values <= chunk_size)
+    {
+        return false;
+    }
+
+    size_t const n_value_objs = n_objs - 1;
+    for(intptr_t begin=0; begin<n_values; begin += chunk_size)
+    {
+        bp::slice const chunk(begin, std::min(begin + chunk_size, n_values));
+        bp::list value_chunks;
+        for(size_t i=0; i<n_value_objs; ++i)
+        {
+            value_chunks.append(is_scalar[i] ? objs[i] : bp::object(objs[i][chunk]));
+        }
+        bp::object const weight_chunk = (is_scalar[n_value_objs] ? objs[n_value_objs] : bp::object(objs[n_value_objs][chunk]));
+        if(pack_values_into_tuple)
+        {
+            fill_fct(self, bp::tuple(value_chunks), weight_chunk);
+        }
+        else
+        {
+            fill_fct(self, value_chunks[0], weight_chunk);
+        }
+    }
+    return true;
+}
+
 struct generic_nd_traits
 {
     template <typename BCValueType>
@@ -1044,7 +2097,18 @@ struct generic_nd_traits
         {
             // The ndvalues_obj object is supposed to be a structured ndarray.
 
-            size_t const nd = self.get_nd();
+            std::vector<bp::object> objs;
+            objs.push_back(ndvalues_obj);
+            objs.push_back(weight_obj);
+            std::vector<bn::dtype> dts;
+            dts.push_back(self.get_ndvalues_dtype());
+            dts.push_back(bn::dtype::get_builtin<BCValueType>());
+            if(fill_in_conversion_chunks(self, objs, dts, /*pack_values_into_tuple=*/false, &apply))
+            {
+                return;
+            }
+
+            size_t const n_fill_columns = self.get_n_fill_columns();
             bp::object ndvalues_arr_obj;
             try
             {
@@ -1054,7 +2118,7 @@ struct generic_nd_traits
             {
                 std::stringstream ss;
                 ss << "The ndvalues parameter must either be a tuple of "
-                   << nd << " one-dimensional arrays or one structured "
+                   << n_fill_columns << " one-dimensional arrays or one structured "
                    << "ndarray!";
                 throw TypeError(ss.str());
             }
@@ -1062,11 +2126,16 @@ struct generic_nd_traits
             // Get the byte offsets of the fields and check if the number of fields
             // match the dimensionality of the histogram.
             std::vector<intptr_t> ndvalue_byte_offsets = ndvalues_arr.get_dtype().get_fields_byte_offsets();
-            if(ndvalue_byte_offsets.size() != nd)
+            if(ndvalue_byte_offsets.size() != n_fill_columns)
             {
                 std::stringstream ss;
-                ss << "The value ndarray must contain " << nd << " fields, one for "
-                   << "each dimension! Right now it has "
+                ss << "The value ndarray must contain " << n_fill_columns << " fields, one for "
+                   << "each dimension";
+                if(self.is_profile())
+                {
+                    ss << " and one for the profile value";
+                }
+                ss << "! Right now it has "
                    << ndvalue_byte_offsets.size() << " fields!";
                 throw ValueError(ss.str());
             }
@@ -1138,13 +2207,33 @@ ndhist(
     bp::tuple const & axes
   , bp::object const & dt
   , bp::object const & bc_class
+  , bool const profile
 )
   : nd_(bp::len(axes))
   , ndvalues_dt_(bn::dtype::new_builtin<void>())
   , bc_noe_dt_(bn::dtype::get_builtin<uintptr_t>())
   , bc_weight_dt_(bn::dtype(dt))
   , bc_class_(bc_class)
+  , profile_(profile)
+  , track_unbinned_moments_(false)
+  , shadow_accumulation_(false)
+  , modification_count_(0)
+  , proj_cache_modification_count_(0)
 {
+    // The profile values are converted into the weight data type, so it
+    // must be a floating point type. Otherwise the profile values and sums
+    // would get truncated.
+    if(profile_ && ! (   bn::dtype::equivalent(bc_weight_dt_, bn::dtype::get_builtin<float>())
+                      || bn::dtype::equivalent(bc_weight_dt_, bn::dtype::get_builtin<double>())
+                     )
+      )
+    {
+        std::stringstream ss;
+        ss << "Profile histograms are only supported for floating point "
+           << "weight types, i.e. float32 and float64!";
+        throw TypeError(ss.str());
+    }
+
     std::vector<intptr_t> shape(nd_);
     axes_extension_max_fcap_vec_.resize(nd_);
     axes_extension_max_bcap_vec_.resize(nd_);
@@ -1178,6 +2267,13 @@ ndhist(
         }
 
         // Check if the axis name is unique.
+        if(profile_ && axis_name == "profile_value")
+        {
+            std::stringstream ss;
+            ss << "The name 'profile_value' of axis " << i << " is reserved "
+               << "for the profile value field of a profile histogram!";
+            throw NameError(ss.str());
+        }
         for(size_t k=0; k<axes_.size(); ++k)
         {
             if(axes_[k]->get_name() == axis_name)
@@ -1220,17 +2316,30 @@ ndhist(
         axes_.push_back(axis);
     }
 
+    // Add the profile value field to the ndvalues dtype object.
+    if(profile_)
+    {
+        ndvalues_dt_.add_field("profile_value", bc_weight_dt_);
+    }
+
     // TODO: Make this as an option in the constructor.
     intptr_t value_cache_size = 65536;
 
     // Create a ndarray_storage for the bin content array. Each bin content
     // element consists of three sub-elements:
     // number_of_entries (noe), sum_of_weights (sow), and sum_of_weights_squared
-    // (sows).
+    // (sows). A profile histogram has two additional sub-elements:
+    // sum_of_weighted_profile_values (sowy), and
+    // sum_of_weighted_squared_profile_values (sowyy).
     bn::dtype bc_dt = bn::dtype::new_builtin<void>();
     bc_dt.add_field("noe",  bc_noe_dt_);
     bc_dt.add_field("sow",  bc_weight_dt_);
     bc_dt.add_field("sows", bc_weight_dt_);
+    if(profile_)
+    {
+        bc_dt.add_field("sowy",  bc_weight_dt_);
+        bc_dt.add_field("sowyy", bc_weight_dt_);
+    }
     bc_ = detail::ndarray_storage(bc_dt, shape, axes_extension_max_fcap_vec_, axes_extension_max_bcap_vec_);
 
     // Setup the function pointers and the value cache.
@@ -1270,6 +2379,11 @@ ndhist(
   , bc_noe_dt_(bn::dtype::get_builtin<uintptr_t>())
   , bc_weight_dt_(base.get_weight_dtype())
   , bc_class_(base.get_weight_class())
+  , profile_(base.is_profile())
+  , track_unbinned_moments_(false)
+  , shadow_accumulation_(false)
+  , modification_count_(0)
+  , proj_cache_modification_count_(0)
   , base_(base.shared_from_this())
 {
     if(data_shape.size() != data_strides.size())
@@ -1303,6 +2417,10 @@ ndhist(
 
         axes_.push_back(axis);
     }
+    if(profile_)
+    {
+        ndvalues_dt_.add_field("profile_value", bc_weight_dt_);
+    }
 
     // For a data view no front and back capacity is allowed, because the bins
     // of the additional front and back capacities could overlap with existing
@@ -1343,17 +2461,35 @@ boost::shared_ptr<ndhist>
 ndhist::
 deepcopy() const
 {
-    // Use the default copy constructor, that makes a shallow copy.
-    boost::shared_ptr<ndhist> thecopy = boost::shared_ptr<ndhist>(new ndhist(*this));
+    boost::shared_ptr<ndhist> thecopy = deepcopy_without_bin_content();
 
     // Copy the bytearray, if this ndhist object is not a view.
     std::cout << "ndhist::copy: deepcopying bytearray ..."<<std::flush;
     thecopy->bc_.bytearray_ = bc_.bytearray_->deepcopy();
     std::cout << "done."<<std::endl<<std::flush;
 
+    return thecopy;
+}
+
+boost::shared_ptr<ndhist>
+ndhist::
+deepcopy_without_bin_content() const
+{
+    // Use the default copy constructor, that makes a shallow copy.
+    boost::shared_ptr<ndhist> thecopy = boost::shared_ptr<ndhist>(new ndhist(*this));
+
     // Reset the base object. A deep copy is not a view anymore.
     thecopy->base_ = boost::shared_ptr<ndhist>();
 
+    // Start with a fresh modification count and an empty projection cache,
+    // because the copy owns its own bin content array now.
+    thecopy->modification_count_ = 0;
+    thecopy->clear_projection_cache();
+
+    // The shadow accumulator belongs to the bin content array of this ndhist
+    // object, so the copy creates its own one when needed.
+    thecopy->shadow_accumulator_.reset();
+
     // Copy the value cache.
     std::cout << "ndhist::copy: deepcopying value cache ..."<<std::flush;
     thecopy->value_cache_ = value_cache_->deepcopy();
@@ -1409,18 +2545,36 @@ setup_function_pointers()
     #define NDHIST_WEIGHT_VALUE_TYPE_SUPPORT(r, data, WEIGHT_VALUE_TYPE)    \
         if(bn::dtype::equivalent(bc_weight_dt_, bn::dtype::get_builtin<WEIGHT_VALUE_TYPE>()))\
         {                                                                   \
-            iadd_fct_ = &detail::iadd_fct_traits<WEIGHT_VALUE_TYPE>::apply; \
+            iadd_fct_ = &detail::inplace_op_fct_traits<WEIGHT_VALUE_TYPE, detail::iadd_op>::apply; \
+            isub_fct_ = &detail::inplace_op_fct_traits<WEIGHT_VALUE_TYPE, detail::isub_op>::apply; \
             idiv_fct_ = &detail::idiv_fct_traits<WEIGHT_VALUE_TYPE>::apply; \
             imul_fct_ = &detail::imul_fct_traits<WEIGHT_VALUE_TYPE>::apply; \
             get_weight_type_field_axes_oor_ndarrays_fct_ = &detail::get_field_axes_oor_ndarrays<WEIGHT_VALUE_TYPE>;\
             project_fct_ = &detail::project_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
+            project_many_fct_ = &detail::project_many_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
             merge_axis_bins_fct_ = &detail::merge_axis_bins_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
             clear_fct_ = &detail::clear_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
             get_binerror_ndarray_fct_ = &detail::get_binerror_ndarray_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
+            get_profile_ndarray_fct_ = &detail::get_profile_ndarray_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
+            get_axis_cumsow_fct_ = &detail::get_axis_cumsow_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
+            fill_summed_area_table_fct_ = &detail::fill_summed_area_table_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
         }
     BOOST_PP_SEQ_FOR_EACH(NDHIST_WEIGHT_VALUE_TYPE_SUPPORT, ~, NDHIST_TYPE_SUPPORT_WEIGHT_VALUE_TYPES)
     #undef NDHIST_WEIGHT_VALUE_TYPE_SUPPORT
 
+    // The single-pass rebinning allocates a new (zero initialized) bin content
+    // array, which cannot hold object bin contents. For object weights the
+    // merge_bins method falls back to the per-axis in-place rebinning, and the
+    // rebin_to method is not supported.
+    #define NDHIST_WEIGHT_VALUE_TYPE_SUPPORT(r, data, WEIGHT_VALUE_TYPE)    \
+        if(bn::dtype::equivalent(bc_weight_dt_, bn::dtype::get_builtin<WEIGHT_VALUE_TYPE>()))\
+        {                                                                   \
+            merge_bins_fct_ = &detail::merge_bins_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
+            rebin_axis_fct_ = &detail::rebin_axis_fct_traits<WEIGHT_VALUE_TYPE>::apply;\
+        }
+    BOOST_PP_SEQ_FOR_EACH(NDHIST_WEIGHT_VALUE_TYPE_SUPPORT, ~, NDHIST_TYPE_SUPPORT_WEIGHT_VALUE_TYPES_WITHOUT_OBJECT)
+    #undef NDHIST_WEIGHT_VALUE_TYPE_SUPPORT
+
     get_noe_type_field_axes_oor_ndarrays_fct_ = &detail::get_field_axes_oor_ndarrays<uintptr_t>;
 }
 
@@ -1462,17 +2616,56 @@ calc_core_bin_content_ndarray_settings(
             }
             if(axes_[i]->has_overflow_bin())
             {
-                shape[i] -= 1;
-                back_capacity[i] += 1;
+                shape[i] -= 1;
+                back_capacity[i] += 1;
+            }
+        }
+    }
+}
+
+ndhist &
+ndhist::operator+=(ndhist const & rhs)
+{
+    check_writeable("add to");
+    iadd_fct_(*this, rhs);
+    if(track_unbinned_moments_)
+    {
+        if(rhs.is_tracking_unbinned_moments())
+        {
+            for(uintptr_t i=0; i<nd_; ++i)
+            {
+                unbinned_moments_[i].merge(rhs.unbinned_moments_[i]);
             }
         }
+        else
+        {
+            set_track_unbinned_moments(false);
+        }
     }
+    increment_modification_count();
+    return *this;
 }
 
 ndhist &
-ndhist::operator+=(ndhist const & rhs)
+ndhist::operator-=(ndhist const & rhs)
 {
-    iadd_fct_(*this, rhs);
+    check_writeable("subtract from");
+    isub_fct_(*this, rhs);
+    if(track_unbinned_moments_)
+    {
+        if(rhs.is_tracking_unbinned_moments())
+        {
+            for(uintptr_t i=0; i<nd_; ++i)
+            {
+                unbinned_moments_[i].unmerge(rhs.unbinned_moments_[i]);
+            }
+        }
+        else
+        {
+            set_track_unbinned_moments(false);
+        }
+    }
+    increment_modification_count();
     return *this;
 }
 
@@ -1768,6 +2961,9 @@ is_compatible(ndhist const & other) const
     if(nd_ != other.nd_) {
         return false;
     }
+    if(profile_ != other.profile_) {
+        return false;
+    }
     for(uintptr_t i=0; i<nd_; ++i)
     {
         bn::ndarray const this_axis_edges_arr = this->get_axes()[i]->get_binedges_ndarray();
@@ -1784,50 +2980,518 @@ is_compatible(ndhist const & other) const
         }
     }
 
-    return true;
+    return true;
+}
+
+void
+ndhist::
+check_writeable(char const * what) const
+{
+    if(is_readonly())
+    {
+        std::stringstream ss;
+        ss << "The ndhist object is read-only! Unable to " << what << " it. "
+           << "Use the deepcopy method to get a writeable copy.";
+        throw ValueError(ss.str());
+    }
+}
+
+detail::profile_sums_offsets
+ndhist::
+get_profile_sums_offsets() const
+{
+    if(! profile_)
+    {
+        return detail::profile_sums_offsets();
+    }
+    return detail::profile_sums_offsets(bc_.get_dtype());
+}
+
+void
+ndhist::
+count_writeable_bc_ndarray_release() const
+{
+    // Writes through the released ndarray cannot be tracked. So count its
+    // release as a modification, which invalidates the projection cache (and
+    // the summed-area table) calculated before.
+    if(! is_readonly())
+    {
+        const_cast<ndhist *>(this)->increment_modification_count();
+    }
+}
+
+void
+ndhist::
+clear()
+{
+    check_writeable("clear");
+    clear_fct_(*this);
+    for(uintptr_t i=0; i<unbinned_moments_.size(); ++i)
+    {
+        unbinned_moments_[i].clear();
+    }
+    increment_modification_count();
+}
+
+ndhist
+ndhist::
+empty_like() const
+{
+    bp::list axis_list;
+    for(uintptr_t i=0; i<nd_; ++i)
+    {
+        axis_list.append(axes_[i]->deepcopy());
+    }
+    bp::tuple axes(axis_list);
+    ndhist newhist(axes, bc_weight_dt_, bc_class_, profile_);
+    newhist.set_track_unbinned_moments(track_unbinned_moments_);
+    return newhist;
+}
+
+/**
+ * Throws a TypeError if the given axis is a category axis. The bins of a
+ * category axis have no numeric bin edges, so the what operation, which needs
+ * them, is not supported for it.
+ */
+static
+void
+check_axis_is_not_categorical(
+    Axis const & axis
+  , intptr_t const axis_idx
+  , char const * what
+)
+{
+    if(dynamic_cast<axes::CategoryAxis const *>(&axis.get_axis_base()))
+    {
+        std::stringstream ss;
+        ss << "The axis "<<axis_idx<<" is a category axis. Category axes do "
+           << "not support to "<<what<<"!";
+        throw TypeError(ss.str());
+    }
+}
+
+static
+std::set<intptr_t>
+get_projection_axes_set(intptr_t const nd, bp::object const & dims)
+{
+    bn::ndarray axes_arr = bn::from_object(dims, bn::dtype::get_builtin<intptr_t>(), 0, 1, bn::ndarray::ALIGNED);
+    std::set<intptr_t> axes;
+    bn::iterators::flat_iterator< bn::iterators::single_value<intptr_t> > axes_arr_iter(axes_arr);
+    while(! axes_arr_iter.is_end())
+    {
+        intptr_t axis = detail::adjust_axis_index(nd, *axes_arr_iter);
+        if(! axes.insert(axis).second)
+        {
+            std::stringstream ss;
+            ss << "The axis value \""<< axis <<"\" has been "
+               << "specified at least twice!";
+            throw ValueError(ss.str());
+        }
+        ++axes_arr_iter;
+    }
+    return axes;
+}
+
+boost::shared_ptr<ndhist>
+ndhist::
+project(bp::object const & dims) const
+{
+    std::set<intptr_t> const axes = get_projection_axes_set(get_nd(), dims);
+
+    // Return a deep copy of the cached projection, so the user can alter it
+    // without corrupting the projection cache.
+    return get_projection(axes)->deepcopy();
+}
+
+boost::shared_ptr<ndhist const>
+ndhist::
+get_projection(std::set<intptr_t> const & axes) const
+{
+    validate_projection_cache();
+
+    std::map< std::set<intptr_t>, boost::shared_ptr<ndhist const> >::const_iterator const it = proj_cache_.find(axes);
+    if(it != proj_cache_.end())
+    {
+        return it->second;
+    }
+
+    boost::shared_ptr<ndhist> proj = project_fct_(*this, axes);
+    proj->bc_.bytearray_->set_readonly();
+    proj_cache_[axes] = proj;
+    return proj;
+}
+
+boost::shared_ptr<ndhist const>
+ndhist::
+get_projection(intptr_t const axis) const
+{
+    std::set<intptr_t> axes;
+    axes.insert(detail::adjust_axis_index(get_nd(), axis));
+    return get_projection(axes);
+}
+
+std::vector<double> const &
+ndhist::
+get_axis_cumulative_sow(intptr_t axis) const
+{
+    axis = detail::adjust_axis_index(get_nd(), axis);
+
+    validate_projection_cache();
+    std::map< intptr_t, std::vector<double> >::const_iterator const it = axis_cumsow_cache_.find(axis);
+    if(it != axis_cumsow_cache_.end())
+    {
+        return it->second;
+    }
+
+    std::vector<double> cumsow;
+    if(nd_ == 1)
+    {
+        get_axis_cumsow_fct_(*this, cumsow);
+    }
+    else
+    {
+        boost::shared_ptr<ndhist const> const proj = get_projection(axis);
+        get_axis_cumsow_fct_(*proj, cumsow);
+    }
+    std::vector<double> & cached_cumsow = axis_cumsow_cache_[axis];
+    cached_cumsow.swap(cumsow);
+    return cached_cumsow;
+}
+
+boost::shared_ptr<detail::summed_area_table const>
+ndhist::
+get_summed_area_table() const
+{
+    validate_projection_cache();
+    if(sat_cache_)
+    {
+        return sat_cache_;
+    }
+
+    boost::shared_ptr<detail::summed_area_table> sat(new detail::summed_area_table(bc_.get_shape_vector()));
+    fill_summed_area_table_fct_(*this, *sat);
+    sat_cache_ = sat;
+    return sat_cache_;
+}
+
+void
+ndhist::
+get_integral_sums(
+    std::vector<intptr_t> const & lower
+  , std::vector<intptr_t> const & upper
+  , double & noe
+  , double & sow
+  , double & sows
+) const
+{
+    if(lower.size() != nd_ || upper.size() != nd_)
+    {
+        std::stringstream ss;
+        ss << "The lower and upper bin index ranges must be given for all "
+           << nd_ <<" axes!";
+        throw ValueError(ss.str());
+    }
+
+    // Convert the visible bin indices into the indices of the bin content
+    // array, i.e. including the under- and overflow bins.
+    std::vector<intptr_t> const nbins = get_nbins();
+    std::vector<intptr_t> bc_lower(nd_);
+    std::vector<intptr_t> bc_upper(nd_);
+    for(uintptr_t i=0; i<nd_; ++i)
+    {
+        if(lower[i] < 0 || upper[i] > nbins[i] || lower[i] > upper[i])
+        {
+            std::stringstream ss;
+            ss << "The bin index range ["<<lower[i]<<", "<<upper[i]<<") of "
+               << "axis "<<i<<" is invalid! It must lie within the interval "
+               << "[0, "<<nbins[i]<<"].";
+            throw IndexError(ss.str());
+        }
+        intptr_t const offset = axes_[i]->has_underflow_bin();
+        bc_lower[i] = lower[i] + offset;
+        bc_upper[i] = upper[i] + offset;
+    }
+
+    get_summed_area_table()->get_box_sums(bc_lower, bc_upper, noe, sow, sows);
+}
+
+void
+ndhist::
+get_integral_box(
+    bp::object const & ranges
+  , std::vector<intptr_t> & lower
+  , std::vector<intptr_t> & upper
+) const
+{
+    lower.assign(nd_, 0);
+    upper = get_nbins();
+    if(ranges == bp::object())
+    {
+        return;
+    }
+    if(intptr_t(bp::len(ranges)) != intptr_t(nd_))
+    {
+        std::stringstream ss;
+        ss << "The ranges sequence must contain one (start, stop) bin index "
+           << "range (or None) for each of the "<<nd_<<" axes!";
+        throw ValueError(ss.str());
+    }
+    for(uintptr_t i=0; i<nd_; ++i)
+    {
+        bp::object const range = ranges[i];
+        if(range == bp::object())
+        {
+            continue;
+        }
+        if(bp::len(range) != 2)
+        {
+            std::stringstream ss;
+            ss << "The range of axis "<<i<<" must be a (start, stop) bin index "
+               << "pair!";
+            throw ValueError(ss.str());
+        }
+        lower[i] = bp::extract<intptr_t>(range[0]);
+        upper[i] = bp::extract<intptr_t>(range[1]);
+    }
+}
+
+double
+ndhist::
+integral(bp::object const & ranges) const
+{
+    std::vector<intptr_t> lower;
+    std::vector<intptr_t> upper;
+    get_integral_box(ranges, lower, upper);
+    double noe, sow, sows;
+    get_integral_sums(lower, upper, noe, sow, sows);
+    return sow;
+}
+
+bp::tuple
+ndhist::
+py_get_integral_sums(bp::object const & ranges) const
+{
+    std::vector<intptr_t> lower;
+    std::vector<intptr_t> upper;
+    get_integral_box(ranges, lower, upper);
+    double noe, sow, sows;
+    get_integral_sums(lower, upper, noe, sow, sows);
+    return bp::make_tuple(noe, sow, sows);
+}
+
+void
+ndhist::
+clear_projection_cache() const
+{
+    proj_cache_.clear();
+    axis_cumsow_cache_.clear();
+    sat_cache_.reset();
+}
+
+void
+ndhist::
+validate_projection_cache() const
+{
+    uintptr_t const modification_count = get_modification_count();
+    if(proj_cache_modification_count_ != modification_count)
+    {
+        clear_projection_cache();
+        proj_cache_modification_count_ = modification_count;
+    }
+}
+
+void
+ndhist::
+set_track_unbinned_moments(bool const track)
+{
+    if(! track)
+    {
+        track_unbinned_moments_ = false;
+        unbinned_moments_.clear();
+        axis_value_to_double_fcts_.clear();
+        return;
+    }
+
+    if(is_view())
+    {
+        std::stringstream ss;
+        ss << "The tracking of the unbinned moments is not supported for "
+           << "data views!";
+        throw TypeError(ss.str());
+    }
+
+    std::vector<double (*)(char * const)> fcts(nd_, NULL);
+    for(uintptr_t i=0; i<nd_; ++i)
+    {
+        bn::dtype const axis_dt = axes_[i]->get_dtype();
+        #define NDHIST_AXIS_VALUE_TYPE_SUPPORT(r, data, AXIS_VALUE_TYPE)    \
+            if(bn::dtype::equivalent(axis_dt, bn::dtype::get_builtin<AXIS_VALUE_TYPE>()))\
+            {                                                               \
+                fcts[i] = &detail::axis_value_to_double<AXIS_VALUE_TYPE>;   \
+            }
+        BOOST_PP_SEQ_FOR_EACH(NDHIST_AXIS_VALUE_TYPE_SUPPORT, ~, NDHIST_TYPE_SUPPORT_AXIS_VALUE_TYPES_WITHOUT_OBJECT)
+        #undef NDHIST_AXIS_VALUE_TYPE_SUPPORT
+        if(fcts[i] == NULL)
+        {
+            std::stringstream ss;
+            ss << "The tracking of the unbinned moments is only supported for "
+               << "axes with POD values! Axis " << i << " does not have POD "
+               << "values.";
+            throw TypeError(ss.str());
+        }
+    }
+
+    track_unbinned_moments_ = true;
+    unbinned_moments_.assign(nd_, detail::unbinned_moments());
+    axis_value_to_double_fcts_ = fcts;
+}
+
+void
+ndhist::
+set_shadow_accumulation(bool const enable)
+{
+    if(! enable)
+    {
+        shadow_accumulation_ = false;
+        shadow_accumulator_.reset();
+        return;
+    }
+
+    if(is_view())
+    {
+        std::stringstream ss;
+        ss << "The shadow accumulation is not supported for data views!";
+        throw TypeError(ss.str());
+    }
+    if(profile_ || ! bn::dtype::equivalent(bc_weight_dt_, bn::dtype::get_builtin<double>()))
+    {
+        std::stringstream ss;
+        ss << "The shadow accumulation is only supported for non-profile "
+           << "histograms with float64 weights!";
+        throw TypeError(ss.str());
+    }
+
+    shadow_accumulation_ = true;
+}
+
+detail::unbinned_moments const &
+ndhist::
+get_unbinned_moments(intptr_t axis) const
+{
+    if(! track_unbinned_moments_)
+    {
+        std::stringstream ss;
+        ss << "The tracking of the unbinned moments is not enabled for this "
+           << "ndhist object!";
+        throw AssertionError(ss.str());
+    }
+    axis = detail::adjust_axis_index(nd_, axis);
+    return unbinned_moments_[axis];
+}
+
+double
+ndhist::
+get_unbinned_mean(intptr_t axis) const
+{
+    return get_unbinned_moments(axis).get_mean();
+}
+
+double
+ndhist::
+get_unbinned_var(intptr_t axis) const
+{
+    return get_unbinned_moments(axis).get_var();
+}
+
+bp::tuple
+ndhist::
+py_get_unbinned_sums(intptr_t axis) const
+{
+    detail::unbinned_moments const & moments = get_unbinned_moments(axis);
+    return bp::make_tuple(moments.get_sow(), moments.get_sum_wx(), moments.get_sum_wx2());
 }
 
 void
 ndhist::
-clear()
+scale_unbinned_moments(double const factor)
 {
-    clear_fct_(*this);
+    for(uintptr_t i=0; i<unbinned_moments_.size(); ++i)
+    {
+        unbinned_moments_[i].scale(factor);
+    }
 }
 
-ndhist
+bp::tuple
 ndhist::
-empty_like() const
+project_many(bp::object const & dims_seq) const
 {
-    bp::list axis_list;
-    for(uintptr_t i=0; i<nd_; ++i)
+    intptr_t const nd = get_nd();
+    intptr_t const n_projs = bp::len(dims_seq);
+    std::vector< std::set<intptr_t> > axes_sets;
+    axes_sets.reserve(n_projs);
+    for(intptr_t i=0; i<n_projs; ++i)
     {
-        axis_list.append(axes_[i]->deepcopy());
+        axes_sets.push_back(get_projection_axes_set(nd, dims_seq[i]));
     }
-    bp::tuple axes(axis_list);
-    return ndhist(axes, bc_weight_dt_, bc_class_);
+
+    std::vector< boost::shared_ptr<ndhist const> > const projs = get_projections(axes_sets);
+
+    // Return deep copies of the cached projections, so the user can alter
+    // them without corrupting the projection cache.
+    bp::list proj_list;
+    for(intptr_t i=0; i<n_projs; ++i)
+    {
+        proj_list.append(projs[i]->deepcopy());
+    }
+    return bp::tuple(proj_list);
 }
 
-ndhist
+std::vector< boost::shared_ptr<ndhist const> >
 ndhist::
-project(bp::object const & dims) const
+get_projections(std::vector< std::set<intptr_t> > const & axes_sets) const
 {
-    intptr_t const nd = get_nd();
-    bn::ndarray axes_arr = bn::from_object(dims, bn::dtype::get_builtin<intptr_t>(), 0, 1, bn::ndarray::ALIGNED);
-    std::set<intptr_t> axes;
-    bn::iterators::flat_iterator< bn::iterators::single_value<intptr_t> > axes_arr_iter(axes_arr);
-    while(! axes_arr_iter.is_end())
+    // Determine the projections, which are not available in the projection
+    // cache, and calculate them all at once.
+    validate_projection_cache();
+    std::vector< std::set<intptr_t> > missing_axes_sets;
+    for(size_t i=0; i<axes_sets.size(); ++i)
     {
-        intptr_t axis = detail::adjust_axis_index(nd, *axes_arr_iter);
-        if(! axes.insert(axis).second)
+        if(   proj_cache_.find(axes_sets[i]) == proj_cache_.end()
+           && std::find(missing_axes_sets.begin(), missing_axes_sets.end(), axes_sets[i]) == missing_axes_sets.end()
+          )
         {
-            std::stringstream ss;
-            ss << "The axis value \""<< axis <<"\" has been "
-               << "specified at least twice!";
-            throw ValueError(ss.str());
+            missing_axes_sets.push_back(axes_sets[i]);
         }
-        ++axes_arr_iter;
     }
-    return project_fct_(*this, axes);
+    if(! missing_axes_sets.empty())
+    {
+        std::vector< boost::shared_ptr<ndhist> > const projs = project_many_fct_(*this, missing_axes_sets);
+        for(size_t i=0; i<missing_axes_sets.size(); ++i)
+        {
+            projs[i]->bc_.bytearray_->set_readonly();
+            proj_cache_[missing_axes_sets[i]] = projs[i];
+        }
+    }
+
+    std::vector< boost::shared_ptr<ndhist const> > projs;
+    projs.reserve(axes_sets.size());
+    for(size_t i=0; i<axes_sets.size(); ++i)
+    {
+        projs.push_back(proj_cache_[axes_sets[i]]);
+    }
+    return projs;
+}
+
+std::vector< boost::shared_ptr<ndhist const> >
+ndhist::
+get_axis_projections() const
+{
+    std::vector< std::set<intptr_t> > axes_sets(nd_);
+    for(uintptr_t i=0; i<nd_; ++i)
+    {
+        axes_sets[i].insert(i);
+    }
+    return get_projections(axes_sets);
 }
 
 boost::shared_ptr<ndhist>
@@ -1848,6 +3512,9 @@ merge_axis_bins(
         return self;
     }
 
+    intptr_t const axis_idx = detail::adjust_axis_index(nd_, axis);
+    check_axis_is_not_categorical(*axes_[axis_idx], axis_idx, "merge bins");
+
     // Make a deepcopy if this ndhist object is a data view into an other
     // ndhist object, or the user explicitly requested a copy.
     // Otherwise the rebin operation would invalidate the
@@ -1856,8 +3523,13 @@ merge_axis_bins(
     {
         self = this->deepcopy();
     }
+    else
+    {
+        check_writeable("merge the bins of");
+    }
 
     merge_axis_bins_fct_(*self, axis, nbins_to_merge);
+    self->increment_modification_count();
 
     return self;
 }
@@ -1897,20 +3569,90 @@ merge_bins(
         return self;
     }
 
-    // Make a deepcopy if this ndhist object is a data view into an other
-    // ndhist object, or the user explicitly requested a copy.
-    // Otherwise the rebin operation would invalidate the
-    // original ndhist object.
-    if(is_view() || copy)
+    // Collect the number of bins to merge for each axis. The single-pass
+    // rebinning can be used only if each axis is specified at most once.
+    std::vector<intptr_t> axes_nbins_to_merge(nd_, 1);
+    bool is_single_pass = bool(merge_bins_fct_);
+    for(size_t i=0; i<axes.size(); ++i)
     {
-        self = this->deepcopy();
+        intptr_t axis = axes[i];
+        if(   (axis < 0 && intptr_t(axis + nd_) < 0)
+           || (axis >= 0 && axis >= intptr_t(nd_))
+          )
+        {
+            std::stringstream ss;
+            ss << "The axis value '"<<axis<<"' is invalid. It must be within "
+               << "the interval ["<< -intptr_t(nd_) <<", "<< nd_-1 <<"]!";
+            throw ValueError(ss.str());
+        }
+        if(axis < 0)
+        {
+            axis += nd_;
+        }
+        if(nbins_to_merge[i] >= 2)
+        {
+            // Reject category axes before any axis gets rebinned, so this
+            // ndhist object is not left partially rebinned.
+            check_axis_is_not_categorical(*axes_[axis], axis, "merge bins");
+        }
+        if(axes_nbins_to_merge[axis] != 1)
+        {
+            is_single_pass = false;
+        }
+        axes_nbins_to_merge[axis] = nbins_to_merge[i];
     }
 
-    for(size_t i=0; i<axes.size(); ++i)
+    if(! is_single_pass)
+    {
+        // Make a deepcopy if this ndhist object is a data view into an other
+        // ndhist object, or the user explicitly requested a copy.
+        // Otherwise the rebin operation would invalidate the
+        // original ndhist object.
+        if(is_view() || copy)
+        {
+            self = this->deepcopy();
+        }
+        else
+        {
+            check_writeable("merge the bins of");
+        }
+
+        for(size_t i=0; i<axes.size(); ++i)
+        {
+            merge_axis_bins_fct_(*self, axes[i], nbins_to_merge[i]);
+        }
+        self->increment_modification_count();
+
+        return self;
+    }
+
+    std::vector<intptr_t> const self_nbins = get_nbins();
+    for(uintptr_t i=0; i<nd_; ++i)
+    {
+        if(axes_nbins_to_merge[i] > self_nbins[i])
+        {
+            std::stringstream ss;
+            ss << "The number of bins to merge for axis "<<i<<" must be "
+               << "within the interval [0, "<<self_nbins[i]<<"]!";
+            throw ValueError(ss.str());
+        }
+    }
+
+    // The single-pass rebinning writes into a new bin content array, so a
+    // copy does not need to copy the bin content array of this ndhist object
+    // first. It just reads from it.
+    if(is_view() || copy)
+    {
+        self = this->deepcopy_without_bin_content();
+    }
+    else
     {
-        merge_axis_bins_fct_(*self, axes[i], nbins_to_merge[i]);
+        check_writeable("merge the bins of");
     }
 
+    merge_bins_fct_(*self, axes_nbins_to_merge);
+    self->increment_modification_count();
+
     return self;
 }
 
@@ -1936,6 +3678,120 @@ merge_bins(
     return merge_bins(axes_vec, nbins_to_merge_vec, copy);
 }
 
+boost::shared_ptr<ndhist>
+ndhist::
+rebin_to(
+    intptr_t axis
+  , bp::object const & new_edges
+  , bool const split
+  , bool const copy
+)
+{
+    boost::shared_ptr<ndhist> self = this->shared_from_this();
+
+    if(   (axis < 0 && intptr_t(axis + nd_) < 0)
+       || (axis >= 0 && axis >= intptr_t(nd_))
+      )
+    {
+        std::stringstream ss;
+        ss << "The axis value '"<<axis<<"' is invalid. It must be within "
+           << "the interval ["<< -intptr_t(nd_) <<", "<< nd_-1 <<"]!";
+        throw ValueError(ss.str());
+    }
+    if(axis < 0)
+    {
+        axis += nd_;
+    }
+
+    if(! rebin_axis_fct_)
+    {
+        std::stringstream ss;
+        ss << "The rebin_to method is not supported for histograms with "
+           << "object weights!";
+        throw TypeError(ss.str());
+    }
+    Axis const & oldaxis = *axes_[axis];
+    if(bn::dtype::equivalent(oldaxis.get_dtype(), bn::dtype::get_builtin<bp::object>()))
+    {
+        std::stringstream ss;
+        ss << "The rebin_to method is not supported for axes with object "
+           << "values!";
+        throw TypeError(ss.str());
+    }
+    check_axis_is_not_categorical(oldaxis, axis, "rebin to new bin edges");
+
+    // Get the old and the new bin edges as double values and calculate the
+    // overlap matrix between the old and the new bins.
+    bn::dtype const dt = bn::dtype::get_builtin<double>();
+    bn::ndarray const old_edges_arr = bn::from_object(oldaxis.get_binedges_ndarray(), dt, 1, 1, bn::ndarray::CARRAY_RO);
+    double const * old_edges_data = reinterpret_cast<double const *>(old_edges_arr.get_data());
+    std::vector<double> const old_edges(old_edges_data, old_edges_data + old_edges_arr.shape(0));
+    bn::ndarray const new_edges_arr = bn::from_object(new_edges, dt, 1, 1, bn::ndarray::CARRAY_RO);
+    double const * new_edges_data = reinterpret_cast<double const *>(new_edges_arr.get_data());
+    std::vector<double> const new_edges_vec(new_edges_data, new_edges_data + new_edges_arr.shape(0));
+    detail::axis_overlap_matrix const om(old_edges, oldaxis.has_underflow_bin(), oldaxis.has_overflow_bin(), new_edges_vec, split);
+
+    // Convert the new edges into the data type of the old axis. They must be
+    // exactly representable in that data type, e.g. integral for an integer
+    // axis.
+    bn::ndarray const new_edges_axis_arr = bn::from_object(new_edges_arr.attr("astype")(oldaxis.get_dtype()));
+    bn::ndarray const new_edges_back_arr = bn::from_object(new_edges_axis_arr.attr("astype")(dt), dt, 1, 1, bn::ndarray::CARRAY_RO);
+    double const * new_edges_back_data = reinterpret_cast<double const *>(new_edges_back_arr.get_data());
+    for(size_t i=0; i<new_edges_vec.size(); ++i)
+    {
+        if(new_edges_back_data[i] != new_edges_vec[i])
+        {
+            std::stringstream ss;
+            ss << "The new edge "<< new_edges_vec[i] <<" is not exactly "
+               << "representable by the data type of the axis values!";
+            throw ValueError(ss.str());
+        }
+    }
+
+    // Create the new axis object, which uses the data type of the old axis.
+    // The edges of the under- and overflow bins are taken from the old axis.
+    std::vector<intptr_t> const shape(1, om.get_edges().size());
+    bp::object edges = bn::empty(shape, oldaxis.get_dtype());
+    bp::object const old_edges_axis_arr = oldaxis.get_binedges_ndarray();
+    intptr_t const first = (om.has_underflow_bin() ? 1 : 0);
+    if(om.has_underflow_bin())
+    {
+        edges[0] = old_edges_axis_arr[0];
+    }
+    edges[bp::slice(first, first + intptr_t(new_edges_vec.size()))] = new_edges_axis_arr;
+    if(om.has_overflow_bin())
+    {
+        edges[-1] = old_edges_axis_arr[-1];
+    }
+    boost::shared_ptr<Axis> newaxis(new axes::py::generic_axis(
+        bn::from_object(edges)
+      , oldaxis.get_label()
+      , oldaxis.get_name()
+      , om.has_underflow_bin()
+      , om.has_overflow_bin()
+    ));
+
+    // The rebinning writes into a new bin content array, so a copy does not
+    // need to copy the bin content array of this ndhist object first.
+    if(is_view() || copy)
+    {
+        self = this->deepcopy_without_bin_content();
+    }
+    else
+    {
+        check_writeable("rebin");
+    }
+
+    // The new axis is not extendable, so it does not need any extra capacity.
+    self->axes_extension_max_fcap_vec_[axis] = 0;
+    self->axes_extension_max_bcap_vec_[axis] = 0;
+    rebin_axis_fct_(*self, axis, om);
+    self->axes_[axis] = newaxis;
+    self->increment_modification_count();
+
+    return self;
+}
+
 bp::tuple
 ndhist::
 py_get_shape() const
@@ -1992,6 +3848,7 @@ py_get_noe_ndarray() const
     intptr_t const sub_item_byte_offset = 0;
 
     bn::ndarray arr = detail::ndarray_storage::construct_ndarray(bc_, bc_noe_dt_, shape, front_capacity, back_capacity, sub_item_byte_offset, /*owner=*/NULL, /*set_owndata_flag=*/false);
+    count_writeable_bc_ndarray_release();
     if(nd_ == 0)
     {
         return arr.scalarize();
@@ -2014,6 +3871,7 @@ py_get_full_noe_ndarray() const
       , /*owner=*/NULL
       , /*set_owndata_flag=*/false
     );
+    count_writeable_bc_ndarray_release();
     if(nd_ == 0)
     {
         return arr.scalarize();
@@ -2036,6 +3894,7 @@ py_get_sow_ndarray() const
     intptr_t const sub_item_byte_offset = bc_.get_dtype().get_fields_byte_offsets()[1];
 
     bn::ndarray arr = detail::ndarray_storage::construct_ndarray(bc_, bc_weight_dt_, shape, front_capacity, back_capacity, sub_item_byte_offset, /*owner=*/NULL, /*set_owndata_flag=*/false);
+    count_writeable_bc_ndarray_release();
     if(nd_ == 0)
     {
         return arr.scalarize();
@@ -2058,6 +3917,7 @@ py_get_full_sow_ndarray() const
       , /*owner=*/NULL
       , /*set_owndata_flag=*/false
     );
+    count_writeable_bc_ndarray_release();
     if(nd_ == 0)
     {
         return arr.scalarize();
@@ -2080,6 +3940,7 @@ py_get_sows_ndarray() const
     intptr_t const sub_item_byte_offset = bc_.get_dtype().get_fields_byte_offsets()[2];
 
     bn::ndarray arr = detail::ndarray_storage::construct_ndarray(bc_, bc_weight_dt_, shape, front_capacity, back_capacity, sub_item_byte_offset, /*owner=*/NULL, /*set_owndata_flag=*/false);
+    count_writeable_bc_ndarray_release();
     if(nd_ == 0)
     {
         return arr.scalarize();
@@ -2102,6 +3963,7 @@ py_get_full_sows_ndarray() const
       , /*owner=*/NULL
       , /*set_owndata_flag=*/false
     );
+    count_writeable_bc_ndarray_release();
     if(nd_ == 0)
     {
         return arr.scalarize();
@@ -2121,6 +3983,136 @@ py_get_binerror_ndarray() const
     return arr;
 }
 
+static
+void
+assert_profile(ndhist const & h)
+{
+    if(! h.is_profile())
+    {
+        std::stringstream ss;
+        ss << "This ndhist object is not a profile histogram!";
+        throw TypeError(ss.str());
+    }
+}
+
+bp::object
+ndhist::
+py_get_profile_sum_ndarray() const
+{
+    assert_profile(*this);
+
+    std::vector<intptr_t> shape;
+    std::vector<intptr_t> front_capacity;
+    std::vector<intptr_t> back_capacity;
+    calc_core_bin_content_ndarray_settings(shape, front_capacity, back_capacity);
+
+    intptr_t const sub_item_byte_offset = bc_.get_dtype().get_fields_byte_offsets()[3];
+
+    bn::ndarray arr = detail::ndarray_storage::construct_ndarray(bc_, bc_weight_dt_, shape, front_capacity, back_capacity, sub_item_byte_offset, /*owner=*/NULL, /*set_owndata_flag=*/false);
+    count_writeable_bc_ndarray_release();
+    if(nd_ == 0)
+    {
+        return arr.scalarize();
+    }
+    return arr;
+}
+
+bp::object
+ndhist::
+py_get_full_profile_sum_ndarray() const
+{
+    assert_profile(*this);
+
+    intptr_t const sub_item_byte_offset = bc_.get_dtype().get_fields_byte_offsets()[3];
+    bn::ndarray arr = detail::ndarray_storage::construct_ndarray(
+        bc_
+      , bc_weight_dt_
+      , bc_.get_shape_vector()
+      , bc_.get_front_capacity_vector()
+      , bc_.get_back_capacity_vector()
+      , sub_item_byte_offset
+      , /*owner=*/NULL
+      , /*set_owndata_flag=*/false
+    );
+    count_writeable_bc_ndarray_release();
+    if(nd_ == 0)
+    {
+        return arr.scalarize();
+    }
+    return arr;
+}
+
+bp::object
+ndhist::
+py_get_profile_squaredsum_ndarray() const
+{
+    assert_profile(*this);
+
+    std::vector<intptr_t> shape;
+    std::vector<intptr_t> front_capacity;
+    std::vector<intptr_t> back_capacity;
+    calc_core_bin_content_ndarray_settings(shape, front_capacity, back_capacity);
+
+    intptr_t const sub_item_byte_offset = bc_.get_dtype().get_fields_byte_offsets()[4];
+
+    bn::ndarray arr = detail::ndarray_storage::construct_ndarray(bc_, bc_weight_dt_, shape, front_capacity, back_capacity, sub_item_byte_offset, /*owner=*/NULL, /*set_owndata_flag=*/false);
+    count_writeable_bc_ndarray_release();
+    if(nd_ == 0)
+    {
+        return arr.scalarize();
+    }
+    return arr;
+}
+
+bp::object
+ndhist::
+py_get_full_profile_squaredsum_ndarray() const
+{
+    assert_profile(*this);
+
+    intptr_t const sub_item_byte_offset = bc_.get_dtype().get_fields_byte_offsets()[4];
+    bn::ndarray arr = detail::ndarray_storage::construct_ndarray(
+        bc_
+      , bc_weight_dt_
+      , bc_.get_shape_vector()
+      , bc_.get_front_capacity_vector()
+      , bc_.get_back_capacity_vector()
+      , sub_item_byte_offset
+      , /*owner=*/NULL
+      , /*set_owndata_flag=*/false
+    );
+    count_writeable_bc_ndarray_release();
+    if(nd_ == 0)
+    {
+        return arr.scalarize();
+    }
+    return arr;
+}
+
+bp::object
+ndhist::
+py_get_profile_mean_ndarray() const
+{
+    bn::ndarray arr = get_profile_ndarray_fct_(*this, /*calc_std=*/false);
+    if(nd_ == 0)
+    {
+        return arr.scalarize();
+    }
+    return arr;
+}
+
+bp::object
+ndhist::
+py_get_profile_std_ndarray() const
+{
+    bn::ndarray arr = get_profile_ndarray_fct_(*this, /*calc_std=*/true);
+    if(nd_ == 0)
+    {
+        return arr.scalarize();
+    }
+    return arr;
+}
+
 bp::tuple
 ndhist::
 py_get_labels() const
@@ -2453,12 +4445,15 @@ void
 ndhist::
 py_fill(bp::object const & ndvalue_obj, bp::object weight_obj)
 {
+    check_writeable("fill");
+
     // In case None is given as weight, we will use one.
     if(weight_obj == bp::object())
     {
         weight_obj = bp::object(1);
     }
     fill_fct_(*this, ndvalue_obj, weight_obj);
+    increment_modification_count();
 }
 
 // TODO: Use the new multi_axis_iter for this.
@@ -2643,6 +4638,7 @@ extend_axes(
             axis.extend(f_n_extra_bins_vec[i], b_n_extra_bins_vec[i]);
         }
     }
+    increment_modification_count();
 }
 
 void
@@ -2654,6 +4650,7 @@ extend_bin_content_array(
 {
     // Extend the bin content array. This might cause a reallocation of memory.
     bc_.extend_axes(f_n_extra_bins_vec, b_n_extra_bins_vec, axes_extension_max_fcap_vec_, axes_extension_max_bcap_vec_);
+    increment_modification_count();
 
     // We need to initialize the new bin content values, if the data type
     // is object.
@@ -22,6 +22,7 @@
 #include <ndhist/type_support.hpp>
 #include <ndhist/detail/utils.hpp>
 #include <ndhist/stats/expectation.hpp>
+#include <ndhist/stats/detail/utils.hpp>
 
 namespace bp = boost::python;
 namespace bn = boost::numpy;
@@ -53,6 +54,9 @@ calc_axis_expectation(
         throw TypeError(ss.str());
     }
 
+    // Check that the axis has numeric bins.
+    ::ndhist::stats::detail::check_axis_is_not_categorical(h, axis_idx, "expectation");
+
     #define NDHIST_MULTPLEX(r, seq)                                             \
         if(   bn::dtype::equivalent(h.get_axes()[axis_idx]->get_dtype(), bn::dtype::get_builtin<BOOST_PP_SEQ_ELEM(0,seq)>())\
            && bn::dtype::equivalent(h.get_weight_dtype(), bn::dtype::get_builtin<BOOST_PP_SEQ_ELEM(1,seq)>())\
@@ -96,6 +100,8 @@ expectation(
         return detail::calc_axis_expectation(h, n, 0);
     }
 
+    ::ndhist::stats::detail::cache_axis_projections(h);
+
     // Return a tuple holding the expectation values for each single axis.
     std::vector<bp::object> expectations;
     expectations.reserve(nd);
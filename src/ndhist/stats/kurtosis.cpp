@@ -24,6 +24,7 @@
 #include <ndhist/type_support.hpp>
 #include <ndhist/detail/utils.hpp>
 #include <ndhist/stats/kurtosis.hpp>
+#include <ndhist/stats/detail/utils.hpp>
 
 namespace bp = boost::python;
 namespace bn = boost::numpy;
@@ -55,6 +56,9 @@ calc_axis_kurtosis(
         throw TypeError(ss.str());
     }
 
+    // Check that the axis has numeric bins.
+    ::ndhist::stats::detail::check_axis_is_not_categorical(h, axis_idx, "kurtosis");
+
     #define NDHIST_MULTPLEX(r, seq)                                             \
         if(   bn::dtype::equivalent(theaxis.get_dtype(), bn::dtype::get_builtin<BOOST_PP_SEQ_ELEM(0,seq)>())\
            && bn::dtype::equivalent(h.get_weight_dtype(), bn::dtype::get_builtin<BOOST_PP_SEQ_ELEM(1,seq)>())\
@@ -97,6 +101,8 @@ kurtosis(
         return detail::calc_axis_kurtosis(h, 0);
     }
 
+    ::ndhist::stats::detail::cache_axis_projections(h);
+
     // Return a tuple holding the kurtosis values for each single axis.
     std::vector<bp::object> kurtosises;
     kurtosises.reserve(nd);
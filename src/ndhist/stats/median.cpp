@@ -25,6 +25,7 @@
 #include <ndhist/type_support.hpp>
 #include <ndhist/detail/utils.hpp>
 #include <ndhist/stats/median.hpp>
+#include <ndhist/stats/detail/utils.hpp>
 
 namespace ndhist {
 namespace stats {
@@ -38,8 +39,10 @@ calc_axis_median_impl(
   , intptr_t const axis
 )
 {
-    // Project the given histogram to the given axis (if nd > 1).
-    ndhist const proj = (h.get_nd() == 1 ? h : h.project(bp::object(axis)));
+    // Get the (cached) projection of the given histogram to the given axis
+    // (if nd > 1).
+    boost::shared_ptr<ndhist const> const proj_ptr = (h.get_nd() == 1 ? boost::shared_ptr<ndhist const>() : h.get_projection(axis));
+    ndhist const & proj = (proj_ptr ? *proj_ptr : h);
 
     // Iterate over the bins (which are along the given axis) and exclude
     // possible under- and overflow bins.
@@ -154,6 +157,9 @@ calc_axis_median(
         throw TypeError(ss.str());
     }
 
+    // Check that the axis has numeric bins.
+    ::ndhist::stats::detail::check_axis_is_not_categorical(h, axis_idx, "median");
+
     #define NDHIST_MULTPLEX(r, seq)                                             \
         if(   bn::dtype::equivalent(h.get_axes()[axis_idx]->get_dtype(), bn::dtype::get_builtin<BOOST_PP_SEQ_ELEM(0,seq)>())\
            && bn::dtype::equivalent(h.get_weight_dtype(), bn::dtype::get_builtin<BOOST_PP_SEQ_ELEM(1,seq)>())\
@@ -196,6 +202,8 @@ median(
         return detail::calc_axis_median(h, 0);
     }
 
+    ::ndhist::stats::detail::cache_axis_projections(h);
+
     // Return a tuple holding the moment values for each single axis.
     std::vector<bp::object> medians;
     medians.reserve(nd);
@@ -0,0 +1,156 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#include <sstream>
+#include <vector>
+
+#include <boost/python.hpp>
+
+#include <boost/numpy/dtype.hpp>
+#include <boost/numpy/ndarray.hpp>
+#include <boost/numpy/iterators/flat_iterator.hpp>
+#include <boost/numpy/python/make_tuple_from_container.hpp>
+
+#include <ndhist/error.hpp>
+#include <ndhist/ndhist.hpp>
+#include <ndhist/detail/utils.hpp>
+#include <ndhist/stats/quantile.hpp>
+#include <ndhist/stats/detail/utils.hpp>
+
+namespace bp = boost::python;
+namespace bn = boost::numpy;
+
+namespace ndhist {
+namespace stats {
+namespace py {
+
+namespace detail {
+
+static
+bp::object
+make_quantiles_object(
+    std::vector<double> const & quantiles
+  , bool const is_scalar
+)
+{
+    if(is_scalar)
+    {
+        return bp::object(quantiles[0]);
+    }
+
+    intptr_t shape[1];
+    shape[0] = quantiles.size();
+    bn::ndarray quantiles_arr = bn::empty(1, shape, bn::dtype::get_builtin<double>());
+    bn::iterators::flat_iterator< bn::iterators::single_value<double> > iter(quantiles_arr);
+    for(size_t i=0; i<quantiles.size(); ++i)
+    {
+        iter.set_value(quantiles[i]);
+        ++iter;
+    }
+    return quantiles_arr;
+}
+
+bp::object
+calc_axis_quantile(
+    ndhist const & h
+  , std::vector<double> const & qs
+  , bool const is_scalar
+  , intptr_t const axis
+  , bool const interpolate
+)
+{
+    // Determine the correct axis index and get the Axis object.
+    intptr_t const axis_idx = ::ndhist::detail::adjust_axis_index(h.get_nd(), axis);
+    Axis const & theaxis = *h.get_axes()[axis_idx];
+
+    // Check that the axis and weight types are not bp::object.
+    if(   theaxis.has_object_value_dtype()
+       || h.has_object_weight_dtype()
+    )
+    {
+        std::stringstream ss;
+        ss << "The axis and weight data types must be POD types. Non-POD types "
+           << "are not supported by the quantile function!";
+        throw TypeError(ss.str());
+    }
+
+    // Check that the axis has numeric bins.
+    ::ndhist::stats::detail::check_axis_is_not_categorical(h, axis_idx, "quantile");
+
+    // The quantiles are calculated from the cumulative sum of weights and
+    // the bin edges and centers as double values, so no dispatch on the axis
+    // and weight value types is required.
+    std::vector<double> quantiles;
+    ::ndhist::stats::detail::calc_axis_quantiles_impl(h, qs, axis_idx, interpolate, quantiles);
+    return make_quantiles_object(quantiles, is_scalar);
+}
+
+}// namespace detail
+
+bp::object
+quantile(
+    ndhist const & h
+  , bp::object const & q
+  , bp::object const & axis
+  , bool const interpolate
+)
+{
+    // Convert the given quantile probabilities into a vector.
+    bn::ndarray q_arr = bn::from_object(q, bn::dtype::get_builtin<double>(), 0, 1, bn::ndarray::ALIGNED);
+    bool const is_scalar = (q_arr.get_nd() == 0);
+    std::vector<double> qs;
+    qs.reserve(q_arr.get_size());
+    bn::iterators::flat_iterator< bn::iterators::single_value<double> > q_iter(q_arr);
+    while(! q_iter.is_end())
+    {
+        qs.push_back(*q_iter);
+        ++q_iter;
+    }
+    if(qs.empty())
+    {
+        std::stringstream ss;
+        ss << "At least one quantile probability must be given!";
+        throw ValueError(ss.str());
+    }
+
+    if(axis != bp::object())
+    {
+        // A particular axis is given. So calculate the quantiles only for that
+        // axis.
+        intptr_t const axis_idx = bp::extract<intptr_t>(axis);
+        return detail::calc_axis_quantile(h, qs, is_scalar, axis_idx, interpolate);
+    }
+
+    // No axis was specified, so calculate the quantiles for all axes.
+    intptr_t const nd = h.get_nd();
+
+    // Return the quantiles of the single axis if the dimensionality of the
+    // histogram is 1.
+    if(nd == 1)
+    {
+        return detail::calc_axis_quantile(h, qs, is_scalar, 0, interpolate);
+    }
+
+    ::ndhist::stats::detail::cache_axis_projections(h);
+
+    // Return a tuple holding the quantiles for each single axis.
+    std::vector<bp::object> quantiles;
+    quantiles.reserve(nd);
+    for(intptr_t i=0; i<nd; ++i)
+    {
+        quantiles.push_back(detail::calc_axis_quantile(h, qs, is_scalar, i, interpolate));
+    }
+    return boost::python::make_tuple_from_container(quantiles.begin(), quantiles.end());
+}
+
+}// namespace py
+}// namespace stats
+}// namespace ndhist
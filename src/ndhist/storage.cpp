@@ -9,13 +9,40 @@
  * (See LICENSE file).
  *
  */
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <stdint.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/ref.hpp>
 #include <boost/python.hpp>
 #include <boost/python/import.hpp>
 
+#include <boost/numpy.hpp>
+
+#include <ndhist/error.hpp>
+#include <ndhist/limits.hpp>
 #include <ndhist/storage.hpp>
+#include <ndhist/type_support.hpp>
+#include <ndhist/axes/category_axis.hpp>
+#include <ndhist/axes/generic_axis.hpp>
+#include <ndhist/axes/linear_axis.hpp>
+#include <ndhist/axes/log10_axis.hpp>
+#include <ndhist/detail/mapped_bytearray.hpp>
+#include <ndhist/detail/ndarray_storage.hpp>
 
 namespace bp = boost::python;
+namespace bn = boost::numpy;
 
 namespace ndhist {
 
@@ -44,4 +71,518 @@ histload(
     return bp::extract< boost::shared_ptr<ndhist> >(py_histload(f, histgroup));
 }
 
+namespace detail {
+
+// The layout of a native ndhist file is:
+//
+//   - The fixed-size preamble: the magic string, the format version, the
+//     byte order mark, the size of the header (i.e. the file offset of the raw
+//     bin content block), and the size of the raw bin content block.
+//   - The title, weight dtype, the profile flag, and the axis descriptors.
+//   - The shape, front and back capacities of the bin content storage.
+//   - Zero padding up to the next multiple of
+//     NDHIST_LIMIT_NATIVE_STORAGE_DATA_ALIGNMENT bytes.
+//   - The raw bin content block, i.e. the complete bytearray of the
+//     histogram, including the extra capacities of extendable axes.
+//
+// All numbers are stored in the byte order of the writing machine.
+static char const     NATIVE_MAGIC[8]         = {'N','D','H','I','S','T','\0','\1'};
+static uint32_t const NATIVE_VERSION          = 1;
+static uint32_t const NATIVE_BYTE_ORDER_MARK  = 0x01020304;
+static size_t const   NATIVE_PREAMBLE_SIZE    = 8 + 4 + 4 + 8 + 8;
+
+enum native_axis_kind_t
+{
+    NATIVE_AXIS_GENERIC  = 1,
+    NATIVE_AXIS_LINEAR   = 2,
+    NATIVE_AXIS_LOG10    = 3,
+    NATIVE_AXIS_CATEGORY = 4
+};
+
+/**
+ * The native_header_writer class serializes POD values, strings, and raw
+ * bytes into a contiguous header buffer.
+ */
+class native_header_writer
+{
+  public:
+    void
+    put_bytes(void const * data, size_t const n)
+    {
+        buf_.append(static_cast<char const *>(data), n);
+    }
+
+    template <typename T>
+    void
+    put(T const value)
+    {
+        put_bytes(&value, sizeof(T));
+    }
+
+    void
+    put_string(std::string const & str)
+    {
+        put<uint64_t>(str.size());
+        put_bytes(str.data(), str.size());
+    }
+
+    std::string buf_;
+};
+
+/**
+ * The native_header_reader class deserializes the values written by the
+ * native_header_writer class. It raises a ValueError if the header ends
+ * prematurely.
+ */
+class native_header_reader
+{
+  public:
+    native_header_reader(char const * data, size_t const size, std::string const & filename)
+      : p_(data)
+      , end_(data + size)
+      , filename_(filename)
+    {}
+
+    void
+    check_size(uint64_t const n) const
+    {
+        if(uint64_t(end_ - p_) < n)
+        {
+            std::stringstream ss;
+            ss << "The header of the ndhist file \"" << filename_ << "\" is "
+               << "truncated or corrupt!";
+            throw ValueError(ss.str());
+        }
+    }
+
+    void
+    get_bytes(void * data, size_t const n)
+    {
+        check_size(n);
+        memcpy(data, p_, n);
+        p_ += n;
+    }
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        get_bytes(&value, sizeof(T));
+        return value;
+    }
+
+    std::string
+    get_string()
+    {
+        uint64_t const n = get<uint64_t>();
+        check_size(n);
+        std::string str(p_, size_t(n));
+        p_ += n;
+        return str;
+    }
+
+  protected:
+    char const *      p_;
+    char const *      end_;
+    std::string const filename_;
+};
+
+static
+void
+throw_file_error(std::string const & what, std::string const & filename)
+{
+    std::stringstream ss;
+    ss << "Unable to " << what << " the ndhist file \"" << filename << "\": "
+       << strerror(errno);
+    throw RuntimeError(ss.str());
+}
+
+static
+std::string
+get_dtype_str(bn::dtype const & dt)
+{
+    return bp::extract<std::string>(dt.attr("str"));
+}
+
+static
+native_axis_kind_t
+get_native_axis_kind(Axis const & axis, intptr_t const idx)
+{
+    Axis const & axisbase = axis.get_axis_base();
+    if(dynamic_cast<axes::CategoryAxis const *>(&axisbase))
+    {
+        return NATIVE_AXIS_CATEGORY;
+    }
+    #define NDHIST_DETAIL_NATIVE_AXIS_KIND(r, data, AXIS_VALUE_TYPE)            \
+        if(dynamic_cast<axes::LinearAxis<AXIS_VALUE_TYPE> const *>(&axisbase))  \
+        {                                                                       \
+            return NATIVE_AXIS_LINEAR;                                          \
+        }                                                                       \
+        if(dynamic_cast<axes::Log10Axis<AXIS_VALUE_TYPE> const *>(&axisbase))   \
+        {                                                                       \
+            return NATIVE_AXIS_LOG10;                                           \
+        }                                                                       \
+        if(dynamic_cast<axes::GenericAxis<AXIS_VALUE_TYPE> const *>(&axisbase)) \
+        {                                                                       \
+            return NATIVE_AXIS_GENERIC;                                         \
+        }
+    BOOST_PP_SEQ_FOR_EACH(NDHIST_DETAIL_NATIVE_AXIS_KIND, ~, NDHIST_TYPE_SUPPORT_AXIS_VALUE_TYPES_WITHOUT_OBJECT)
+    #undef NDHIST_DETAIL_NATIVE_AXIS_KIND
+
+    std::stringstream ss;
+    ss << "The axis " << idx << " (\"" << axis.get_name() << "\") has an "
+       << "axis type that is not supported by the native ndhist file format!";
+    throw TypeError(ss.str());
+}
+
+static
+void
+put_ndarray(native_header_writer & writer, bn::ndarray const & arr)
+{
+    bn::ndarray const carr = bn::from_object(arr, arr.get_dtype(), 1, 1, bn::ndarray::CARRAY_RO);
+    writer.put_string(get_dtype_str(carr.get_dtype()));
+    writer.put<int64_t>(carr.shape(0));
+    writer.put_bytes(carr.get_data(), carr.shape(0) * carr.get_dtype().get_itemsize());
+}
+
+static
+bn::ndarray
+get_ndarray(native_header_reader & reader)
+{
+    bn::dtype const dt = bn::dtype(bp::str(reader.get_string()));
+    std::vector<intptr_t> const shape(1, intptr_t(reader.get<int64_t>()));
+    bn::ndarray arr = bn::empty(shape, dt);
+    reader.get_bytes(arr.get_data(), shape[0] * dt.get_itemsize());
+    return arr;
+}
+
+static
+void
+put_axis(native_header_writer & writer, Axis const & axis, intptr_t const idx)
+{
+    if(bn::dtype::equivalent(axis.get_dtype(), bn::dtype::get_builtin<bp::object>()))
+    {
+        std::stringstream ss;
+        ss << "Only ndhist objects with POD axis value types can be stored to "
+           << "a native ndhist file. Axis " << idx << " does not have a POD "
+           << "value type!";
+        throw TypeError(ss.str());
+    }
+
+    native_axis_kind_t const kind = get_native_axis_kind(axis, idx);
+    writer.put<uint32_t>(kind);
+    writer.put_string(axis.get_label());
+    writer.put_string(axis.get_name());
+    writer.put<uint8_t>(axis.has_underflow_bin());
+    writer.put<uint8_t>(axis.has_overflow_bin());
+    writer.put<uint8_t>(axis.is_extendable());
+    // The ndhist constructor adds one extra capacity bin (for the under- and
+    // overflow bins) to the maximal capacities of extendable axes. So we store
+    // the capacities as they were given to the axis constructor.
+    intptr_t const cap_shift = (axis.is_extendable() ? 1 : 0);
+    writer.put<int64_t>(axis.get_extension_max_fcap() - cap_shift);
+    writer.put<int64_t>(axis.get_extension_max_bcap() - cap_shift);
+    if(kind == NATIVE_AXIS_CATEGORY)
+    {
+        axes::CategoryAxis const & cataxis = *static_cast<axes::CategoryAxis const *>(&axis.get_axis_base());
+        put_ndarray(writer, cataxis.py_get_categories());
+    }
+    else
+    {
+        put_ndarray(writer, axis.get_binedges_ndarray());
+    }
+}
+
+static
+bp::object
+get_axis(native_header_reader & reader)
+{
+    uint32_t const kind            = reader.get<uint32_t>();
+    std::string const label        = reader.get_string();
+    std::string const name         = reader.get_string();
+    bool const has_underflow_bin   = reader.get<uint8_t>();
+    bool const has_overflow_bin    = reader.get<uint8_t>();
+    bool const is_extendable       = reader.get<uint8_t>();
+    intptr_t const extension_max_fcap = reader.get<int64_t>();
+    intptr_t const extension_max_bcap = reader.get<int64_t>();
+    bn::ndarray const arr = get_ndarray(reader);
+
+    boost::shared_ptr<Axis> axis;
+    if(kind == NATIVE_AXIS_GENERIC)
+    {
+        axis = boost::shared_ptr<Axis>(new axes::py::generic_axis(arr, label, name, has_underflow_bin, has_overflow_bin));
+    }
+    else if(kind == NATIVE_AXIS_LINEAR)
+    {
+        axis = boost::shared_ptr<Axis>(new axes::py::linear_axis(arr, label, name, has_underflow_bin, has_overflow_bin, is_extendable, extension_max_fcap, extension_max_bcap));
+    }
+    else if(kind == NATIVE_AXIS_LOG10)
+    {
+        axis = boost::shared_ptr<Axis>(new axes::py::log10_axis(arr, label, name, has_underflow_bin, has_overflow_bin, is_extendable, extension_max_fcap, extension_max_bcap));
+    }
+    else if(kind == NATIVE_AXIS_CATEGORY)
+    {
+        axis = boost::shared_ptr<Axis>(new axes::CategoryAxis(arr, label, name, has_overflow_bin, is_extendable, extension_max_bcap));
+    }
+    else
+    {
+        std::stringstream ss;
+        ss << "The axis type " << kind << " of the axis \"" << name << "\" is "
+           << "unknown! Make sure that the versions of the stored data and "
+           << "the software match!";
+        throw TypeError(ss.str());
+    }
+    return bp::object(axis);
+}
+
+}// namespace detail
+
+void
+histsave_native(
+    ndhist const & h
+  , std::string const & f
+)
+{
+    if(h.has_object_weight_dtype())
+    {
+        std::stringstream ss;
+        ss << "Only ndhist objects with POD weight types can be stored to a "
+           << "file!";
+        throw TypeError(ss.str());
+    }
+
+    // A view shares the bytearray with its base histogram, so we store a
+    // histogram with its own, compact bin content array instead.
+    if(h.is_view())
+    {
+        ndhist compact = h.empty_like();
+        compact += h;
+        compact.py_set_title(h.py_get_title());
+        histsave_native(compact, f);
+        return;
+    }
+
+    detail::ndarray_storage const & bc = h.bc_;
+    detail::bytearray const & ba = *bc.bytearray_;
+
+    // Build the header.
+    detail::native_header_writer writer;
+    writer.put_bytes(detail::NATIVE_MAGIC, sizeof(detail::NATIVE_MAGIC));
+    writer.put<uint32_t>(detail::NATIVE_VERSION);
+    writer.put<uint32_t>(detail::NATIVE_BYTE_ORDER_MARK);
+    // The header and data sizes are filled in below.
+    writer.put<uint64_t>(0);
+    writer.put<uint64_t>(ba.bytesize_);
+
+    writer.put_string(h.py_get_title());
+    writer.put_string(detail::get_dtype_str(h.get_weight_dtype()));
+    writer.put<uint8_t>(h.is_profile());
+    uintptr_t const nd = h.get_nd();
+    writer.put<uint32_t>(nd);
+    for(uintptr_t i=0; i<nd; ++i)
+    {
+        detail::put_axis(writer, *h.get_axes()[i], i);
+    }
+    for(uintptr_t i=0; i<nd; ++i)
+    {
+        writer.put<int64_t>(bc.get_shape_vector()[i]);
+        writer.put<int64_t>(bc.get_front_capacity_vector()[i]);
+        writer.put<int64_t>(bc.get_back_capacity_vector()[i]);
+    }
+
+    // Pad the header, so the raw bin content block can be mapped into memory.
+    size_t const align = NDHIST_LIMIT_NATIVE_STORAGE_DATA_ALIGNMENT;
+    uint64_t const header_size = (writer.buf_.size() + align - 1)/align*align;
+    writer.buf_.resize(header_size, '\0');
+    memcpy(&writer.buf_[16], &header_size, sizeof(header_size));
+
+    // Write the header and the raw bin content block with a single gathering
+    // write. The kernel might write less than requested, so loop until all
+    // bytes are written.
+    int const fd = open(f.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd == -1)
+    {
+        detail::throw_file_error("create", f);
+    }
+    struct iovec iov[2];
+    iov[0].iov_base = &writer.buf_[0];
+    iov[0].iov_len  = writer.buf_.size();
+    iov[1].iov_base = ba.get();
+    iov[1].iov_len  = ba.bytesize_;
+    struct iovec * iovp = iov;
+    int iovcnt = 2;
+    while(iovcnt > 0)
+    {
+        ssize_t n = writev(fd, iovp, iovcnt);
+        if(n == -1)
+        {
+            if(errno == EINTR) continue;
+            int const err = errno;
+            close(fd);
+            errno = err;
+            detail::throw_file_error("write", f);
+        }
+        while(iovcnt > 0 && size_t(n) >= iovp->iov_len)
+        {
+            n -= iovp->iov_len;
+            ++iovp;
+            --iovcnt;
+        }
+        if(iovcnt > 0)
+        {
+            iovp->iov_base = static_cast<char *>(iovp->iov_base) + n;
+            iovp->iov_len -= n;
+        }
+    }
+    if(close(fd) == -1)
+    {
+        detail::throw_file_error("close", f);
+    }
+}
+
+boost::shared_ptr<ndhist>
+histload_native(
+    std::string const & f
+  , bool const readonly
+)
+{
+    int const fd = open(f.c_str(), O_RDONLY);
+    if(fd == -1)
+    {
+        detail::throw_file_error("open", f);
+    }
+
+    // Read the header. The raw bin content block is not read, but mapped into
+    // memory.
+    std::string header(detail::NATIVE_PREAMBLE_SIZE, '\0');
+    size_t nread = 0;
+    uint64_t header_size = 0;
+    uint64_t data_size = 0;
+    try
+    {
+        while(nread < header.size())
+        {
+            ssize_t const n = pread(fd, &header[nread], header.size() - nread, off_t(nread));
+            if(n == -1)
+            {
+                if(errno == EINTR) continue;
+                detail::throw_file_error("read", f);
+            }
+            if(n == 0)
+            {
+                std::stringstream ss;
+                ss << "The ndhist file \"" << f << "\" is truncated!";
+                throw ValueError(ss.str());
+            }
+            nread += n;
+            if(nread == detail::NATIVE_PREAMBLE_SIZE)
+            {
+                if(memcmp(&header[0], detail::NATIVE_MAGIC, sizeof(detail::NATIVE_MAGIC)) != 0)
+                {
+                    std::stringstream ss;
+                    ss << "The file \"" << f << "\" is not a native ndhist "
+                       << "file!";
+                    throw ValueError(ss.str());
+                }
+                uint32_t version, bom;
+                memcpy(&version, &header[8], sizeof(version));
+                memcpy(&bom, &header[12], sizeof(bom));
+                if(version != detail::NATIVE_VERSION)
+                {
+                    std::stringstream ss;
+                    ss << "The native ndhist file \"" << f << "\" has the "
+                       << "format version " << version << ", but only version "
+                       << detail::NATIVE_VERSION << " is supported!";
+                    throw ValueError(ss.str());
+                }
+                if(bom != detail::NATIVE_BYTE_ORDER_MARK)
+                {
+                    std::stringstream ss;
+                    ss << "The native ndhist file \"" << f << "\" has been "
+                       << "written on a machine with a different byte order!";
+                    throw ValueError(ss.str());
+                }
+                memcpy(&header_size, &header[16], sizeof(header_size));
+                memcpy(&data_size, &header[24], sizeof(data_size));
+                if(header_size < detail::NATIVE_PREAMBLE_SIZE)
+                {
+                    std::stringstream ss;
+                    ss << "The header of the ndhist file \"" << f << "\" is "
+                       << "corrupt!";
+                    throw ValueError(ss.str());
+                }
+                header.resize(header_size);
+            }
+        }
+
+        struct stat st;
+        if(fstat(fd, &st) == -1)
+        {
+            detail::throw_file_error("stat", f);
+        }
+        if(uint64_t(st.st_size) < header_size + data_size)
+        {
+            std::stringstream ss;
+            ss << "The ndhist file \"" << f << "\" is truncated! It has "
+               << st.st_size << " bytes, but " << header_size + data_size
+               << " bytes are required.";
+            throw ValueError(ss.str());
+        }
+
+        detail::native_header_reader reader(&header[detail::NATIVE_PREAMBLE_SIZE], header.size() - detail::NATIVE_PREAMBLE_SIZE, f);
+        std::string const title = reader.get_string();
+        bn::dtype const weight_dt = bn::dtype(bp::str(reader.get_string()));
+        bool const profile = reader.get<uint8_t>();
+        uint32_t const nd = reader.get<uint32_t>();
+        bp::list axis_list;
+        for(uint32_t i=0; i<nd; ++i)
+        {
+            axis_list.append(detail::get_axis(reader));
+        }
+        std::vector<intptr_t> shape(nd);
+        std::vector<intptr_t> front_capacity(nd);
+        std::vector<intptr_t> back_capacity(nd);
+        for(uint32_t i=0; i<nd; ++i)
+        {
+            shape[i]          = reader.get<int64_t>();
+            front_capacity[i] = reader.get<int64_t>();
+            back_capacity[i]  = reader.get<int64_t>();
+        }
+
+        // Create the histogram and replace its (still untouched) bin content
+        // storage with the memory mapped bin content block of the file.
+        boost::shared_ptr<ndhist> h(new ndhist(bp::tuple(axis_list), weight_dt, bp::object(), profile));
+
+        // The stored shape must match the number of bins (including the
+        // under- and overflow bins) of the reconstructed axes, otherwise the
+        // bin content block would be mis-indexed.
+        for(uint32_t i=0; i<nd; ++i)
+        {
+            intptr_t const axis_n_bins = h->get_axes()[i]->get_n_bins();
+            if(shape[i] != axis_n_bins)
+            {
+                std::stringstream ss;
+                ss << "The header of the ndhist file \"" << f << "\" is "
+                   << "corrupt! The stored shape of axis " << i << " is "
+                   << shape[i] << ", but the axis has " << axis_n_bins
+                   << " bins.";
+                throw ValueError(ss.str());
+            }
+        }
+
+        h->py_set_title(title);
+        boost::shared_ptr<detail::bytearray> ba = detail::mapped_bytearray::create(fd, f, header_size, data_size, readonly);
+        h->bc_ = detail::ndarray_storage(h->bc_.get_dtype(), shape, front_capacity, back_capacity, ba);
+
+        close(fd);
+        return h;
+    }
+    catch(...)
+    {
+        close(fd);
+        throw;
+    }
+}
+
 }// namespace ndhist
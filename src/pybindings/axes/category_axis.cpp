@@ -0,0 +1,72 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/python.hpp>
+
+#include <boost/numpy/ndarray.hpp>
+
+#include <ndhist/axis.hpp>
+#include <ndhist/axes/category_axis.hpp>
+
+namespace bp = boost::python;
+namespace bn = boost::numpy;
+
+namespace ndhist {
+namespace axes {
+
+void register_category_axis()
+{
+    bp::class_<CategoryAxis, bp::bases<Axis>, boost::shared_ptr<CategoryAxis> >(
+          "category_axis"
+        , "The category_axis class provides an axis class with one bin per "
+          "category. The categories are given either as an int64 array or as "
+          "an object array of strings. Bin i spans the index range [i, i+1). "
+          "A non-extendable category axis can have an overflow bin for all "
+          "values, that are not a category of the axis. An extendable "
+          "category axis adds unknown categories as new bins at its back "
+          "instead."
+        , bp::init<
+            bn::ndarray const &
+          , std::string const &
+          , std::string const &
+          , bool
+          , bool
+          , intptr_t
+          >(
+          ( bp::arg("self")
+          , bp::arg("categories")
+          , bp::arg("label")=std::string("")
+          , bp::arg("name")=std::string("")
+          , bp::arg("has_overflow_bin")=true
+          , bp::arg("is_extendable")=false
+          , bp::arg("extension_max_bcap")=0
+          )
+          )
+        )
+        .def(axis_pyinterface<CategoryAxis>())
+        .add_property("categories"
+          , &CategoryAxis::py_get_categories
+          , "The ndarray holding the categories of the axis (excluding a "
+            "possible overflow bin)."
+        )
+        .add_property("has_dense_lookup"
+          , &CategoryAxis::has_dense_lookup
+          , "Flag if the integer categories are looked up through a dense "
+            "offset table (True) or through a hash map (False)."
+        )
+    ;
+}
+
+}//namespace axes
+}//namespace ndhist
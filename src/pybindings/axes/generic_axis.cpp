@@ -9,15 +9,20 @@
  * (See LICENSE file).
  *
  */
+#include <sstream>
 #include <string>
 
+#include <boost/preprocessor/seq/for_each.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/python.hpp>
 
+#include <boost/numpy/dtype.hpp>
 #include <boost/numpy/ndarray.hpp>
 
 #include <ndhist/axis.hpp>
 #include <ndhist/axes/generic_axis.hpp>
+#include <ndhist/error.hpp>
+#include <ndhist/type_support.hpp>
 
 namespace bp = boost::python;
 namespace bn = boost::numpy;
@@ -25,6 +30,36 @@ namespace bn = boost::numpy;
 namespace ndhist {
 namespace axes {
 
+static
+void
+generic_axis_set_lut_size(py::generic_axis & self, intptr_t const lut_size)
+{
+    if(lut_size < 0)
+    {
+        std::stringstream ss;
+        ss << "The size of the lookup table must not be negative! It is "
+           << lut_size << ".";
+        throw ValueError(ss.str());
+    }
+
+    // Look up the axis value type of the wrapped GenericAxis object.
+    Axis & axis = self.get_axis_base();
+    bn::dtype const & axis_dtype = axis.get_dtype();
+    #define NDHIST_GENERIC_AXIS_SET_LUT_SIZE(r, data, AXIS_VALUE_TYPE)          \
+        if(bn::dtype::equivalent(axis_dtype, bn::dtype::get_builtin<AXIS_VALUE_TYPE>()))\
+        {                                                                       \
+            static_cast< GenericAxis<AXIS_VALUE_TYPE> & >(axis).set_lut_size(lut_size);\
+            return;                                                             \
+        }
+    BOOST_PP_SEQ_FOR_EACH(NDHIST_GENERIC_AXIS_SET_LUT_SIZE, ~, NDHIST_TYPE_SUPPORT_AXIS_VALUE_TYPES)
+    #undef NDHIST_GENERIC_AXIS_SET_LUT_SIZE
+
+    std::stringstream ss;
+    ss << "The axis value data type is not supported by the generic axis! "
+       << "This is an internal error!";
+    throw TypeError(ss.str());
+}
+
 void register_generic_axis()
 {
     bp::class_<py::generic_axis, bp::bases<Axis>, boost::shared_ptr<py::generic_axis> >(
@@ -50,6 +85,14 @@ void register_generic_axis()
         )
       )
       .def(axis_pyinterface<py::generic_axis>())
+      .def("set_lut_size", &generic_axis_set_lut_size
+        , ( bp::arg("self")
+          , bp::arg("lut_size")
+          )
+        , "Sets the number of slots of the uniform lookup table, that is used "
+          "to accelerate the bin search. A size of 0 disables the lookup "
+          "table. It does not change the bin indices of any value, only the "
+          "speed of the bin search.")
     ;
 }
 
@@ -19,10 +19,12 @@ void register_error_types();
 void register_axis();
 void register_ndhist();
 void register_ndtable();
+void register_storage();
 void register_stats_module();
 
 namespace axes {
 
+void register_category_axis();
 void register_generic_axis();
 void register_linear_axis();
 void register_log10_axis();
@@ -37,10 +39,12 @@ BOOST_PYTHON_MODULE(core)
 
     ndhist::register_error_types();
     ndhist::register_axis();
+    ndhist::axes::register_category_axis();
     ndhist::axes::register_generic_axis();
     ndhist::axes::register_linear_axis();
     ndhist::axes::register_log10_axis();
     ndhist::register_ndhist();
     ndhist::register_ndtable();
+    ndhist::register_storage();
     ndhist::register_stats_module();
 }
@@ -36,10 +36,12 @@ void register_ndhist()
             bp::tuple const &
           , bp::object const &
           , bp::object const &
+          , bool const
           >(
           ( bp::arg("axes")
           , bp::arg("dtype")=bn::dtype::get_builtin<double>()
           , bp::arg("bc_class")=bp::object()
+          , bp::arg("profile")=false
           )
           )
         )
@@ -75,6 +77,19 @@ void register_ndhist()
         .add_property("is_view", &ndhist::is_view
             , "The flag if this ndhist object is a view into the bin content "
               "array of an other ndhist object.")
+        .add_property("is_readonly", &ndhist::is_readonly
+            , "The flag if the bin content array of this ndhist object must "
+              "not be altered, e.g. because it is a read-only memory mapping "
+              "of a file. The deepcopy of a read-only ndhist object is "
+              "writeable.")
+
+        .add_property("modification_count", &ndhist::get_modification_count
+            , "The number of modifications of the bin content array, i.e. the "
+              "number of fill, clear, arithmetic, axis extension, and bin "
+              "merge operations. It is used to invalidate the projection "
+              "cache. Writes through the bin content ndarray properties cannot "
+              "be tracked, so getting a writeable bin content ndarray counts as "
+              "a modification.")
 
         .add_property("base",
               &ndhist::py_get_base
@@ -123,6 +138,71 @@ void register_ndhist()
             , "The ndarray holding the square root of the bin's sum of weights "
               "squared, i.e. the bin error values.")
 
+        //----------------------------------------------------------------------
+        // Profile histogram properties.
+        .add_property("is_profile", &ndhist::is_profile
+            , "Flag if this histogram is a profile histogram. A profile "
+              "histogram is filled with an extra value column (the profile "
+              "value y) after the axis value columns and stores for each bin "
+              "in addition the sums of w*y and w*y^2. Its weight data type "
+              "must be a floating point type.")
+        .add_property("profile_sum", bp::make_function(
+              &ndhist::py_get_profile_sum_ndarray
+            , bn::ndarray_accessor_return())
+            , "The ndarray holding the sum of the weighted profile values "
+              "(w*y) for each bin of a profile histogram. "
+              "It excludes possible under- and overflow bins.")
+        .add_property("full_profile_sum", bp::make_function(
+              &ndhist::py_get_full_profile_sum_ndarray
+            , bn::ndarray_accessor_return())
+            , "The ndarray holding the sum of the weighted profile values "
+              "(w*y) for each bin of a profile histogram. "
+              "In contrast to the ``profile_sum`` property, it includes "
+              "possible under- and overflow bins.")
+        .add_property("profile_squaredsum", bp::make_function(
+              &ndhist::py_get_profile_squaredsum_ndarray
+            , bn::ndarray_accessor_return())
+            , "The ndarray holding the sum of the weighted squared profile "
+              "values (w*y^2) for each bin of a profile histogram. "
+              "It excludes possible under- and overflow bins.")
+        .add_property("full_profile_squaredsum", bp::make_function(
+              &ndhist::py_get_full_profile_squaredsum_ndarray
+            , bn::ndarray_accessor_return())
+            , "The ndarray holding the sum of the weighted squared profile "
+              "values (w*y^2) for each bin of a profile histogram. "
+              "In contrast to the ``profile_squaredsum`` property, it "
+              "includes possible under- and overflow bins.")
+        .add_property("profile_mean", &ndhist::py_get_profile_mean_ndarray
+            , "The float64 ndarray holding the weighted mean of the profile "
+              "values of each bin of a profile histogram. Empty bins are NaN.")
+        .add_property("profile_std", &ndhist::py_get_profile_std_ndarray
+            , "The float64 ndarray holding the weighted standard deviation of "
+              "the profile values of each bin of a profile histogram. Empty "
+              "bins are NaN.")
+
+        //----------------------------------------------------------------------
+        // Unbinned moments properties.
+        .add_property("track_unbinned_moments"
+            , &ndhist::is_tracking_unbinned_moments
+            , &ndhist::set_track_unbinned_moments
+            , "Flag if the unbinned sum of weights, weighted mean, and weighted "
+              "variance of the filled values are tracked for each axis. "
+              "Enabling it resets the accumulators, so only values filled "
+              "afterwards are taken into account. The accumulators are merged "
+              "by the += operator and reset by the clear method.")
+
+        //----------------------------------------------------------------------
+        // Shadow accumulation property.
+        .add_property("shadow_accumulation"
+            , &ndhist::is_using_shadow_accumulation
+            , &ndhist::set_shadow_accumulation
+            , "Flag if filled values are accumulated into a compact float32 "
+              "shadow array first, which is added to the float64 bin content "
+              "array periodically and at the end of each fill. It halves the "
+              "memory touched while filling histograms with many bins, at the "
+              "cost of float32 rounding of the weights. Only float64 "
+              "non-profile histograms, which are not data views, support it.")
+
         //----------------------------------------------------------------------
         // Underflow and overflow properties.
         .add_property("underflow_entries"
@@ -255,7 +335,26 @@ void register_ndhist()
             , (bp::arg("ndvalues"), bp::arg("weight")=bp::object())
             , "Fills the histogram with the given n-dimensional numbers, "
               "weighted by the given weights. If no weights are specified, "
-              "``1`` will be used for each entry.")
+              "``1`` will be used for each entry. For a profile histogram "
+              "the profile values must be given as an extra value column "
+              "after the axis value columns.")
+        .def("get_unbinned_mean", &ndhist::get_unbinned_mean
+            , (bp::arg("self"), bp::arg("axis")=0)
+            , "Gets the exact weighted mean of the (unbinned) values filled "
+              "into the given axis. The tracking of the unbinned moments must "
+              "be enabled via the ``track_unbinned_moments`` property.")
+        .def("get_unbinned_var", &ndhist::get_unbinned_var
+            , (bp::arg("self"), bp::arg("axis")=0)
+            , "Gets the exact weighted variance of the (unbinned) values "
+              "filled into the given axis. The tracking of the unbinned "
+              "moments must be enabled via the ``track_unbinned_moments`` "
+              "property.")
+        .def("get_unbinned_sums", &ndhist::py_get_unbinned_sums
+            , (bp::arg("self"), bp::arg("axis")=0)
+            , "Gets the tuple (sum(w), sum(w*x), sum(w*x^2)) of the "
+              "(unbinned) values x filled into the given axis. The tracking "
+              "of the unbinned moments must be enabled via the "
+              "``track_unbinned_moments`` property.")
         .def("empty_like", &ndhist::empty_like
             , (bp::arg("self"))
             , "Creates a new empty ndhist object having the same binning and "
@@ -271,7 +370,38 @@ void register_ndhist()
               "histogram containing only the dimensions, which have been        \n"
               "specified through the *dims* argument.                           \n"
               "All other dimensions are collapsed (summed) accordingly into     \n"
-              "the remaining specified dimensions.                              \n")
+              "the remaining specified dimensions.                              \n"
+              "Projections are cached until the histogram gets modified.        \n")
+        .def("integral", &ndhist::integral
+            , (bp::arg("self"), bp::arg("ranges")=bp::object())
+            , "Calculates the sum of weights of the box of bins given by "
+              "*ranges*, which must hold a (start, stop) bin index pair, or "
+              "``None`` for all bins, for each axis. The bin indices exclude "
+              "the under- and overflow bins, and the stop index is exclusive. "
+              "If *ranges* is ``None``, all bins (excluding under- and "
+              "overflow bins) are summed.\n"
+              "The sums are looked up from a summed-area table, which is "
+              "calculated when needed and is cached until the histogram is "
+              "modified. So each call costs only 2^ndim lookups.")
+        .def("integral_sums", &ndhist::py_get_integral_sums
+            , (bp::arg("self"), bp::arg("ranges")=bp::object())
+            , "Same as ``integral``, but returns the tuple (noe, sow, sows) "
+              "of the number of entries, the sum of weights, and the sum of "
+              "squared weights of the box of bins.")
+        .def("clear_projection_cache", &ndhist::clear_projection_cache
+            , (bp::arg("self"))
+            , "Removes all cached projections. This is needed only, if the bin  \n"
+              "content got modified directly through the bin content ndarray    \n"
+              "properties.                                                      \n")
+        .def("project_many", &ndhist::project_many
+            , (bp::arg("self"), bp::arg("dims_seq"))
+            , "Creates several projections of this histogram at once. Each     \n"
+              "element of the *dims_seq* sequence specifies the dimensions of   \n"
+              "one projection, like the *dims* argument of the ``project``      \n"
+              "method does. The bin content array of this histogram is          \n"
+              "traversed only once for all projections.                         \n"
+              "It returns a tuple of ndhist objects, one for each element of    \n"
+              "*dims_seq*.                                                      \n")
 
         .def("merge_axis_bins", &ndhist::merge_axis_bins
             , ( bp::arg("self")
@@ -310,6 +440,37 @@ void register_ndhist()
           , "Same as the ``merge_axis_bins`` method but allows to merge bins "
             "of several axes at once.")
 
+        .def("rebin_to", &ndhist::rebin_to
+          , ( bp::arg("self")
+            , bp::arg("axis")
+            , bp::arg("new_edges")
+            , bp::arg("split")=false
+            , bp::arg("copy")=true
+            )
+          , "Rebins the specified axis onto the bins given by the *new_edges* "
+            "array, without refilling the histogram.\n"
+            "\n"
+            "The new edges must be strictly ascending. Old bins outside of "
+            "the range of the new edges go into the under- or overflow bin, "
+            "which will be created if the axis did not have one yet.\n"
+            "If *split* is ``False``, each old bin must lie within exactly "
+            "one new bin, i.e. the new edges must be a subset of the old "
+            "edges. If *split* is ``True``, an old bin overlapping with "
+            "several new bins is split proportional to the overlapping "
+            "lengths, and its number of entries is distributed by cumulative "
+            "rounding.\n"
+            "\n"
+            "The rebinned axis is a non-extendable generic axis. Histograms "
+            "with object weights or object axis values are not supported.\n"
+            "\n"
+            "If this ndhist object is a data view into an other ndhist "
+            "object, or the optional argument *copy* is set to ``True``, "
+            "a copy of this ndhist object is rebinned. Otherwise the "
+            "rebin operation is performed directly on this ndhist object "
+            "itself.\n"
+            "\n"
+            "It returns the changed (this or the copy) ndhist object.")
+
         // Slicing.
         .def("__getitem__", &ndhist::operator[]
             , (bp::arg("self"), bp::arg("arg"))
@@ -318,6 +479,7 @@ void register_ndhist()
 
         // Arithmetic operator overloads.
         .def(bp::self += bp::self)
+        .def(bp::self -= bp::self)
         .def(bp::self + bp::self)
         #define NDHIST_WEIGHT_VALUE_TYPE_SUPPORT(r, data, WEIGHT_VALUE_TYPE)    \
             .def(bp::self *= WEIGHT_VALUE_TYPE ())                              \
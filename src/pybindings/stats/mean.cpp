@@ -28,9 +28,9 @@ void register_mean()
         )
       , "Calculates the mean value along the given axis of the given ndhist  \n"
         "object.                                                             \n"
-        "Since the mean is equal to the first order expectation, this        \n"
-        "function just calls the ``ndhist.stats.expectation`` function to    \n"
-        "calculate the first order expectation value.                        \n"
+        "It is derived from the same single-pass power sums over the bins of \n"
+        "the projection along that axis as the ``ndhist.stats.moments``      \n"
+        "function, and equals the first order expectation value.             \n"
         "If ``None`` is given as axis argument (the default), the mean value \n"
         "for all individual axes of the ndhist object is calculated and      \n"
         "returned as a tuple. But if the dimensionality of the histogram is  \n"
@@ -23,6 +23,8 @@ void register_expectation();
 void register_kurtosis();
 void register_mean();
 void register_median();
+void register_moments();
+void register_quantile();
 void register_skewness();
 void register_std();
 void register_var();
@@ -40,6 +42,8 @@ void register_stats_module()
         stats::register_kurtosis();
         stats::register_mean();
         stats::register_median();
+        stats::register_moments();
+        stats::register_quantile();
         stats::register_skewness();
         stats::register_std();
         stats::register_var();
@@ -0,0 +1,46 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#include <boost/python.hpp>
+
+#include <ndhist/stats/moments.hpp>
+
+namespace bp = boost::python;
+
+namespace ndhist {
+
+namespace stats {
+
+void register_moments()
+{
+    bp::def("moments"
+      , &py::moments
+      , ( bp::arg("hist")
+        , bp::arg("axis")=bp::object()
+        )
+      , "Calculates the moment based statistics quantities along the given  \n"
+        "axis of the given ndhist object with a single iteration over the    \n"
+        "bins of the projection along that axis. It returns a dictionary     \n"
+        "with the keys ``\"mean\"``, ``\"var\"``, ``\"std\"``,               \n"
+        "``\"skewness\"``, ``\"kurtosis\"``, and ``\"excess\"``, which hold  \n"
+        "the same values as the corresponding individual functions.          \n"
+        "If ``None`` is given as axis argument (the default), the moments    \n"
+        "for all individual axes of the ndhist object are calculated and     \n"
+        "returned as a tuple of dictionaries. But if the dimensionality of   \n"
+        "the histogram is 1, a single dictionary is returned.                \n"
+        "                                                                    \n"
+        ".. note:: This function is only defined for ndhist objects with POD \n"
+        "          type axis values AND POD type weight values.              \n"
+    );
+}
+
+}// namespace stats
+}// namespace ndhist
@@ -0,0 +1,58 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#include <boost/python.hpp>
+
+#include <ndhist/stats/quantile.hpp>
+
+namespace bp = boost::python;
+
+namespace ndhist {
+
+namespace stats {
+
+void register_quantile()
+{
+    bp::def("quantile"
+      , &py::quantile
+      , ( bp::arg("hist")
+        , bp::arg("q")
+        , bp::arg("axis")=bp::object()
+        , bp::arg("interpolate")=false
+        )
+      , "Calculates the quantile values for the given probabilities *q*     \n"
+        "along the given axis of the given ndhist object. The quantile value \n"
+        "is defined as the axis value where the fraction *q* of the sum of   \n"
+        "the weights is below that value.                                    \n"
+        "The cumulative sum of weights along the axis is calculated only     \n"
+        "once and is cached by the histogram until it gets modified. All     \n"
+        "requested quantiles are determined by binary searches on it.        \n"
+        "If *interpolate* is ``False`` (the default), the bin center value   \n"
+        "of the bin containing the quantile is returned (or its upper edge,  \n"
+        "if the quantile coincides with it), like the median function does.  \n"
+        "If *interpolate* is ``True``, the quantile value is linearly        \n"
+        "interpolated within that bin.                                       \n"
+        "The quantile values are calculated as float values, also for        \n"
+        "integer axes. If *q* is a scalar, a float scalar is returned,       \n"
+        "otherwise a 1-dimensional float64 ndarray holding the quantile      \n"
+        "values.                                                             \n"
+        "If ``None`` is given as axis argument (the default), the quantiles  \n"
+        "for all individual axes of the ndhist object are calculated and     \n"
+        "returned as a tuple. But if the dimensionality of the histogram is  \n"
+        "1, the quantiles of that single axis are returned.                  \n"
+        "                                                                    \n"
+        ".. note:: This function is only defined for ndhist objects with POD \n"
+        "          type axis values AND POD type weight values.              \n"
+    );
+}
+
+}// namespace stats
+}// namespace ndhist
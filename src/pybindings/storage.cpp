@@ -0,0 +1,47 @@
+/**
+ * $Id$
+ *
+ * Copyright (C)
+ * 2015 - $Date$
+ *     Martin Wolf <ndhist@martin-wolf.org>
+ *
+ * This file is distributed under the BSD 2-Clause Open Source License
+ * (See LICENSE file).
+ *
+ */
+#include <boost/python.hpp>
+
+#include <ndhist/storage.hpp>
+
+namespace bp = boost::python;
+
+namespace ndhist {
+
+void register_storage()
+{
+    bp::def("histsave_native"
+      , &histsave_native
+      , ( bp::arg("h")
+        , bp::arg("f")
+        )
+      , "Saves the given ndhist object to the given file using the native    \n"
+        "ndhist file format, i.e. a header followed by the raw bin content   \n"
+        "block. Only ndhist objects with POD weight and axis value types can \n"
+        "be stored.                                                          \n"
+    );
+
+    bp::def("histload_native"
+      , &histload_native
+      , ( bp::arg("f")
+        , bp::arg("readonly")=false
+        )
+      , "Loads a ndhist object from the given native ndhist file. The bin    \n"
+        "content of the file is mapped into memory, so only the accessed     \n"
+        "parts of the bin content are read from the file. If readonly is     \n"
+        "``False``, the mapping is copy-on-write, i.e. changes to the loaded \n"
+        "histogram are never written back to the file. If readonly is        \n"
+        "``True``, the loaded histogram cannot be altered.                   \n"
+    );
+}
+
+}// namespace ndhist
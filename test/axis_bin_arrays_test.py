@@ -0,0 +1,44 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_axis_bin_arrays_are_readonly(self):
+        """Tests if the bin edges, bin centers, and bin widths arrays of an
+        axis are read-only and hold the correct values.
+
+        """
+        axis = ndhist.axes.linear(0,4)
+        for arr in (axis.binedges, axis.lower_binedges, axis.upper_binedges,
+                    axis.bincenters, axis.binwidths):
+            self.assertFalse(arr.flags.writeable)
+            with self.assertRaises(ValueError):
+                arr[1] = 42
+
+        self.assertTrue(np.all(axis.binedges == np.array([-np.inf,0,1,2,3,4,+np.inf])))
+        self.assertTrue(np.all(axis.lower_binedges == np.array([-np.inf,0,1,2,3,4])))
+        self.assertTrue(np.all(axis.upper_binedges == np.array([0,1,2,3,4,+np.inf])))
+        self.assertTrue(np.all(axis.bincenters[1:-1] == np.array([0.5,1.5,2.5,3.5])))
+        self.assertTrue(np.all(axis.binwidths[1:-1] == 1))
+
+        # Repeated requests must give the same values.
+        self.assertTrue(np.all(axis.bincenters[1:-1] == np.array([0.5,1.5,2.5,3.5])))
+
+    def test_axis_bin_arrays_after_extension(self):
+        """Tests if the bin arrays of an extendable axis reflect the extension
+        of the axis.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4, extend=True, extracap=10),))
+        self.assertTrue(np.all(h.axes[0].bincenters == np.array([0.5,1.5,2.5,3.5])))
+
+        h.fill(([-1,5],))
+        self.assertTrue(h.nbins == (6,))
+        self.assertTrue(np.all(h.axes[0].binedges == np.array([-1,0,1,2,3,4,5])))
+        self.assertTrue(np.all(h.axes[0].bincenters == np.array([-0.5,0.5,1.5,2.5,3.5,4.5])))
+        self.assertTrue(np.all(h.axes[0].binwidths == 1))
+        self.assertTrue(np.all(h.axes[0].upper_binedges == np.array([0,1,2,3,4,5])))
+
+if(__name__ == "__main__"):
+    unittest.main()
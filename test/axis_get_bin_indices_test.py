@@ -0,0 +1,76 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+def scalar_bin_indices(axis, values):
+    """Gets the bin indices of the given values through the scalar bin search
+    of the fill method, by filling the values one by one.
+
+    """
+    h = ndhist.ndhist((axis,))
+    indices = np.empty((len(values),), dtype=np.intp)
+    for (i, v) in enumerate(values):
+        h.clear()
+        h.fill(np.array([v], dtype=axis.dtype))
+        nz = np.nonzero(h.full_bincontent)[0]
+        indices[i] = nz[0] if len(nz) else -1
+    return indices
+
+class Test(unittest.TestCase):
+    def check_axis(self, axis, values):
+        out = np.empty((len(values),), dtype=np.intp)
+        oor = axis.get_bin_indices(values, out)
+        self.assertTrue(oor.dtype == np.int8)
+        self.assertTrue(np.all(out == scalar_bin_indices(axis, values)))
+        self.assertTrue(np.all((out == -1) == (oor != 0)))
+        return (out, oor)
+
+    def test_generic_axis_get_bin_indices(self):
+        """Tests the batched bin search of a generic axis, including the
+        out-of-range flags.
+
+        """
+        axis = ndhist.core.generic_axis(np.array([0., 1., 2., 5.]), '', '', False, False)
+        (out, oor) = self.check_axis(axis, np.array([-1., 0., 0.5, 1., 4.9, 5., 6.]))
+        self.assertTrue(np.all(out == [-1, 0, 0, 1, 2, -1, -1]))
+        self.assertTrue(np.all(oor == [-1, 0, 0, 0, 0, -2, -2]))
+
+    def test_linear_axis_get_bin_indices(self):
+        """Tests the batched bin search of a linear axis.
+
+        """
+        axis = ndhist.axes.linear(-3, 3, 0.1)
+        rng = np.random.RandomState(42)
+        values = np.concatenate((rng.uniform(-4, 4, 200), axis.binedges[1:-1]))
+        self.check_axis(axis, values)
+
+    def test_log10_axis_get_bin_indices(self):
+        """Tests that the batched bin search of a log10 axis, which uses an
+        approximate log10 transform, gives the same results as the scalar bin
+        search, in particular for values on and next to the bin edges.
+
+        """
+        all_edges = ndhist.axes.log10(0.01, 1e4, width=0.1).binedges
+        for dtype in (np.float64, np.float32):
+            axis = ndhist.core.log10_axis(all_edges.astype(dtype), '', '', True, True)
+            edges = axis.binedges[1:-1].astype(dtype)
+            rng = np.random.RandomState(42)
+            values = np.concatenate((
+                np.power(10, rng.uniform(-3, 5, 200)).astype(dtype),
+                edges,
+                np.nextafter(edges, dtype(0)),
+                np.nextafter(edges, dtype(np.inf)),
+                np.array([0, 1e-40, np.inf], dtype=dtype)))
+            self.check_axis(axis, values)
+
+    def test_category_axis_get_bin_indices(self):
+        """Tests the batched bin search of a category axis.
+
+        """
+        axis = ndhist.axes.category([3, 5, 4, 10])
+        (out, oor) = self.check_axis(axis, np.array([5, 10, 7, 3, 4], dtype=np.int64))
+        self.assertTrue(np.all(out == [1, 3, 4, 0, 2]))
+
+if(__name__ == "__main__"):
+    unittest.main()
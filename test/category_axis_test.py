@@ -0,0 +1,110 @@
+import unittest
+
+import numpy as np
+import ndhist
+from ndhist import stats
+
+class Test(unittest.TestCase):
+    def check_int_fill(self, categories, dense):
+        axis_0 = ndhist.axes.category(categories)
+        self.assertTrue(axis_0.has_dense_lookup == dense)
+        self.assertTrue(np.all(axis_0.categories == categories))
+        h = ndhist.ndhist((axis_0,))
+
+        rng = np.random.RandomState(42)
+        values = np.concatenate((
+            rng.choice(categories, 1000),
+            [min(categories)-1, max(categories)+1]))
+        h.fill(values)
+
+        expected = np.array([np.count_nonzero(values == c) for c in categories])
+        self.assertTrue(np.all(h.bincontent == expected))
+        self.assertTrue(h.full_bincontent[-1] == 2)
+
+    def test_category_axis_dense_int_fill(self):
+        """Tests the dense offset table lookup of integer categories.
+
+        """
+        self.check_int_fill([3, 5, 4, 7, 10], True)
+
+    def test_category_axis_sparse_int_fill(self):
+        """Tests the hash map lookup of sparse integer categories.
+
+        """
+        self.check_int_fill([-1000000, 7, 42, 10**12], False)
+
+    def test_category_axis_string_fill(self):
+        """Tests the filling of a category axis with string categories.
+
+        """
+        axis_0 = ndhist.axes.category(['a', 'bb', 'ccc'])
+        h = ndhist.ndhist((axis_0,))
+        h.fill(np.array(['bb', 'a', 'bb', 'x', 'ccc', 'bb'], dtype=object))
+        self.assertTrue(np.all(h.bincontent == [1, 3, 1]))
+        self.assertTrue(h.full_bincontent[-1] == 1)
+
+        self.assertRaises(ValueError, ndhist.axes.category, ['a', 'a'])
+        self.assertRaises(ValueError, ndhist.axes.category, [1, 2, 1])
+
+    def test_category_axis_growable(self):
+        """Tests that unknown categories are added as new bins at the back
+        of an extendable category axis.
+
+        """
+        axis_0 = ndhist.axes.category([1], extend=True)
+        self.assertTrue(axis_0.is_extendable)
+        self.assertFalse(axis_0.has_overflow_bin)
+        h = ndhist.ndhist((axis_0,))
+        h.fill([5, 1, 5, 3, 1000, 5])
+        self.assertTrue(np.all(h.axes[0].categories == [1, 5, 3, 1000]))
+        self.assertTrue(np.all(h.bincontent == [1, 3, 1, 1]))
+
+        axis_1 = ndhist.axes.category(['a'], extend=True, extracap=2)
+        h = ndhist.ndhist((axis_1,))
+        h.fill(np.array(['b', 'a', 'c', 'b', 'd', 'e', 'c'], dtype=object))
+        self.assertTrue(list(h.axes[0].categories) == ['a', 'b', 'c', 'd', 'e'])
+        self.assertTrue(np.all(h.bincontent == [1, 2, 2, 1, 1]))
+
+    def test_category_axis_growable_oor(self):
+        """Tests that an extendable category axis does not add the category
+        of a value, which is out-of-range on an other (non-extendable) axis.
+
+        """
+        axis_0 = ndhist.axes.category([1], extend=True)
+        axis_1 = ndhist.axes.linear(0, 10, 1,
+            add_underflow_bin=False, add_overflow_bin=False)
+        h = ndhist.ndhist((axis_0, axis_1))
+        h.fill(([1, 2, 3, 2], [0.5, 20.5, 1.5, -1.5]))
+        self.assertTrue(np.all(h.axes[0].categories == [1, 3]))
+        self.assertTrue(h.bincontent.shape == (2, 10))
+        self.assertTrue(h.bincontent[0,0] == 1)
+        self.assertTrue(h.bincontent[1,1] == 1)
+        self.assertTrue(np.sum(h.bincontent) == 2)
+
+    def test_category_axis_growable_overflow(self):
+        """Tests that a directly constructed extendable category axis has no
+        overflow bin, even if one was requested.
+
+        """
+        axis_0 = ndhist.core.category_axis(
+            np.array([1, 2], dtype=np.int64), '', '', True, True, 0)
+        self.assertTrue(axis_0.is_extendable)
+        self.assertFalse(axis_0.has_overflow_bin)
+        h = ndhist.ndhist((axis_0,))
+        self.assertTrue(h.shape == (2,))
+        h.fill([1, 2, 3])
+        self.assertTrue(np.all(h.bincontent == [1, 1, 1]))
+
+    def test_category_axis_stats(self):
+        """Tests that the statistics functions reject category axes.
+
+        """
+        axis_0 = ndhist.axes.category([1, 5, 3])
+        h = ndhist.ndhist((axis_0,))
+        h.fill([1, 5, 5, 3])
+        self.assertRaises(TypeError, stats.mean, h)
+        self.assertRaises(TypeError, stats.median, h)
+        self.assertRaises(TypeError, stats.quantile, h, 0.5)
+
+if(__name__ == "__main__"):
+    unittest.main()
@@ -0,0 +1,72 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_decaying(self):
+        """Tests if the bin contents of a decaying histogram decay as
+        exp(-t/tau).
+
+        """
+        d = ndhist.decaying(ndhist.ndhist((ndhist.axes.linear(0, 10, 1),)), 2.)
+        d.fill([0.5, 1.5], [1., 2.])
+        d.decay(1.)
+        self.assertAlmostEqual(d.scale, np.exp(-0.5))
+        d.fill([0.5])
+
+        h = d.histogram
+        self.assertTrue(np.all(h.binentries[0:3] == np.array([2,1,0])))
+        self.assertAlmostEqual(h.bincontent[0], np.exp(-0.5) + 1.)
+        self.assertAlmostEqual(h.bincontent[1], 2.*np.exp(-0.5))
+        self.assertAlmostEqual(h.squaredweights[1], 4.*np.exp(-1.))
+
+    def test_decaying_renormalization(self):
+        """Tests if the renormalization keeps the true bin contents.
+
+        """
+        d = ndhist.decaying(ndhist.ndhist((ndhist.axes.linear(0, 10, 1),)), 1.)
+        d.fill([0.5])
+        for i in range(200):
+            d.decay(1.)
+            d.fill([0.5])
+        # Without renormalization the scale would have dropped to exp(-200),
+        # which is below the minimal scale.
+        self.assertTrue(np.exp(-200.) < d._min_scale)
+        self.assertTrue(d.scale >= d._min_scale)
+        self.assertTrue(d.scale > np.exp(-200.))
+        h = d.histogram
+        self.assertAlmostEqual(h.bincontent[0], 1./(1. - np.exp(-1.)))
+
+        # An explicit renormalization resets the scale factor without changing
+        # the true bin contents.
+        d.decay(1.)
+        self.assertTrue(d.scale < 1.)
+        h1 = d.histogram
+        d.renormalize()
+        self.assertTrue(d.scale == 1.)
+        h2 = d.histogram
+        self.assertTrue(np.allclose(h2.bincontent, h1.bincontent))
+        self.assertTrue(np.allclose(h2.squaredweights, h1.squaredweights))
+
+    def test_decaying_fill_weights(self):
+        """Tests that filling scales the weights without modifying the given
+        weight array, and that invalid time differences are rejected.
+
+        """
+        d = ndhist.decaying(ndhist.ndhist((ndhist.axes.linear(0, 10, 1),)), 1.)
+        d.decay(np.log(2.))
+        w = np.array([1., 2.])
+        d.fill([0.5, 1.5], w)
+        self.assertTrue(np.all(w == np.array([1., 2.])))
+        d.fill([0.5, 1.5], [1, 2])
+        h = d.histogram
+        self.assertAlmostEqual(h.bincontent[0], 2.)
+        self.assertAlmostEqual(h.bincontent[1], 4.)
+
+        self.assertRaises(ValueError, d.decay, -1.)
+        self.assertRaises(ValueError, d.decay, np.inf)
+        self.assertRaises(ValueError, d.decay, np.nan)
+
+if(__name__ == "__main__"):
+    unittest.main()
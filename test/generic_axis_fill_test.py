@@ -0,0 +1,86 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def check_fill(self, n_edges, n_clustered_edges=0):
+        rng = np.random.RandomState(42)
+        core_edges = np.unique(np.concatenate((
+            rng.uniform(-10, 10, n_edges),
+            rng.uniform(0, 0.01, n_clustered_edges))))
+        edges = np.concatenate(([-np.inf], core_edges, [np.inf]))
+
+        axis_0 = ndhist.core.generic_axis(edges)
+        h = ndhist.ndhist((axis_0,))
+
+        values = np.concatenate((
+            rng.uniform(-12, 12, 10000),
+            rng.uniform(-0.001, 0.011, 1000)))
+        h.fill(values)
+
+        (expected, _) = np.histogram(values, core_edges)
+        self.assertTrue(np.all(h.bincontent == expected))
+        self.assertTrue(h.full_bincontent[0] == np.count_nonzero(values < core_edges[0]))
+        self.assertTrue(h.full_bincontent[-1] == np.count_nonzero(values >= core_edges[-1]))
+
+        # Values equal to an edge belong to the bin starting at that edge.
+        h.clear()
+        h.fill(core_edges[:-1])
+        self.assertTrue(np.all(h.bincontent == 1))
+
+    def test_generic_axis_fill_few_edges(self):
+        """Tests the bin search of the generic axis for a small number of
+        edges, i.e. the linear scan.
+
+        """
+        self.check_fill(10)
+
+    def test_generic_axis_fill_many_edges(self):
+        """Tests the bin search of the generic axis for a large number of
+        edges, i.e. the uniform lookup table and the Eytzinger layout search.
+
+        """
+        self.check_fill(1000)
+
+    def test_generic_axis_fill_clustered_edges(self):
+        """Tests the bin search of the generic axis for edges, which are
+        clustered within a few slots of the uniform lookup table.
+
+        """
+        self.check_fill(100, 1000)
+
+    def test_generic_axis_lut_size(self):
+        """Tests if the bin indices of the generic axis are independent of the
+        size of its uniform lookup table.
+
+        """
+        rng = np.random.RandomState(7)
+        core_edges = np.unique(np.concatenate((
+            rng.uniform(-10, 10, 500),
+            rng.uniform(0, 0.01, 500))))
+        edges = np.concatenate(([-np.inf], core_edges, [np.inf]))
+        values = np.concatenate((
+            rng.uniform(-12, 12, 10000),
+            rng.uniform(-0.001, 0.011, 1000),
+            core_edges))
+
+        axis_0 = ndhist.core.generic_axis(edges)
+        (expected, _) = np.histogram(values, core_edges)
+        expected_indices = np.empty((len(values),), dtype=np.intp)
+        axis_0.get_bin_indices(values, expected_indices)
+        for lut_size in [0, 1, 7, 64, 1024, 100000]:
+            axis = ndhist.core.generic_axis(edges)
+            axis.set_lut_size(lut_size)
+            indices = np.empty((len(values),), dtype=np.intp)
+            axis.get_bin_indices(values, indices)
+            self.assertTrue(np.all(indices == expected_indices))
+
+            h = ndhist.ndhist((axis,))
+            h.fill(values)
+            self.assertTrue(np.all(h.bincontent[:-1] == expected[:-1]))
+
+        self.assertRaises(ValueError, axis_0.set_lut_size, -1)
+
+if(__name__ == "__main__"):
+    unittest.main()
@@ -0,0 +1,39 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_fill_grouped(self):
+        """Tests if filling a grouped histogram gives the same bin contents
+        for each group as filling one histogram per group.
+
+        """
+        proto = ndhist.ndhist((ndhist.axes.linear(0, 10, 1),
+                               ndhist.axes.linear(0, 4, 1)))
+        g = ndhist.grouped(proto, [7])
+
+        rng = np.random.RandomState(42)
+        n = 1000
+        keys = rng.choice([3, 7, 11], n)
+        x = rng.uniform(-1, 11, n)
+        y = rng.uniform(0, 4, n)
+        w = rng.uniform(0, 2, n)
+        g.fill_grouped(keys, (x, y), w)
+        self.assertTrue(sorted(g.keys) == [3, 7, 11])
+        self.assertTrue(g.keys[0] == 7)
+
+        for key in [3, 7, 11]:
+            m = (keys == key)
+            h = proto.empty_like()
+            h.fill((x[m], y[m]), w[m])
+            hg = g.group(key)
+            self.assertTrue(hg.nbins == h.nbins)
+            self.assertTrue(np.all(hg.binentries == h.binentries))
+            self.assertTrue(np.allclose(hg.bincontent, h.bincontent))
+            self.assertTrue(np.allclose(hg.squaredweights, h.squaredweights))
+
+        self.assertRaises(KeyError, g.group, 5)
+
+if(__name__ == "__main__"):
+    unittest.main()
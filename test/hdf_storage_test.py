@@ -0,0 +1,64 @@
+import os
+import shutil
+import tempfile
+import unittest
+
+import numpy as np
+import ndhist
+from ndhist import storage
+
+try:
+    import tables
+    HAS_TABLES = True
+except ImportError:
+    HAS_TABLES = False
+
+@unittest.skipIf(not HAS_TABLES, 'The tables package is not available.')
+class Test(unittest.TestCase):
+    def setUp(self):
+        self.tmpdir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.tmpdir)
+
+    def test_hdf_storage_profile_roundtrip(self):
+        """Tests if the profile sums of a profile histogram, including the ones
+        of the under- and overflow bins, survive a round-trip through a HDF
+        file.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4, 1, name='x'),),
+                          dtype=np.float64, profile=True)
+        h.title = 'profile'
+        h.fill(([-1,0.5,0.5,2.5,5], [1,2,4,3,7]), [1,2,1,3,1])
+
+        fn = os.path.join(self.tmpdir, 'h.hdf')
+        storage.histsave(h, fn, where='/', name='h')
+        h2 = storage.histload(fn, '/h')
+
+        self.assertTrue(h2.is_profile)
+        self.assertTrue(h2.title == h.title)
+        self.assertTrue(np.all(h2.full_binentries == h.full_binentries))
+        self.assertTrue(np.all(h2.full_bincontent == h.full_bincontent))
+        self.assertTrue(np.all(h2.full_squaredweights == h.full_squaredweights))
+        self.assertTrue(np.all(h2.full_profile_sum == h.full_profile_sum))
+        self.assertTrue(np.all(h2.full_profile_squaredsum == h.full_profile_squaredsum))
+        self.assertTrue(np.all(h2.profile_sum == np.array([8,0,9,0])))
+
+    def test_hdf_storage_roundtrip(self):
+        """Tests if a non-profile histogram is loaded as a non-profile
+        histogram.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4, 1),), dtype=np.float64)
+        h.fill([0.5,1.5,1.5], [1,2,3])
+
+        fn = os.path.join(self.tmpdir, 'h.h5')
+        storage.histsave(h, fn, where='/', name='h')
+        h2 = storage.histload(fn, '/h')
+
+        self.assertFalse(h2.is_profile)
+        self.assertTrue(np.all(h2.full_bincontent == h.full_bincontent))
+
+if(__name__ == "__main__"):
+    unittest.main()
@@ -0,0 +1,67 @@
+import unittest
+
+import numpy as np
+import ndhist
+from ndhist import stats
+
+class Test(unittest.TestCase):
+    def assert_moments(self, m, x, w):
+        """Checks the given moments dictionary against the moments of the
+        given axis values x with the weights w.
+
+        """
+        mean = np.sum(w*x)/np.sum(w)
+        var = np.sum(w*(x - mean)**2)/np.sum(w)
+        skewness = np.sum(w*(x - mean)**3)/np.sum(w)/var**1.5
+        kurtosis = np.sum(w*(x - mean)**4)/np.sum(w)/var**2
+        self.assertAlmostEqual(m['mean'], mean)
+        self.assertAlmostEqual(m['var'], var)
+        self.assertAlmostEqual(m['std'], np.sqrt(var))
+        self.assertAlmostEqual(m['skewness'], skewness)
+        self.assertAlmostEqual(m['kurtosis'], kurtosis)
+        self.assertAlmostEqual(m['excess'], kurtosis - 3)
+
+    def test_moments_1d(self):
+        """Tests if the moments function gives the same values as the
+        individual statistics functions for a 1-dimensional histogram, and if
+        the under- and overflow bins are skipped.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0, 4, 1),))
+        h.fill([-1, 0.5, 1.5, 1.5, 3.5, 10], [100, 1, 2, 1, 4, 100])
+
+        m = stats.moments(h)
+        self.assert_moments(m,
+            np.array([0.5, 1.5, 2.5, 3.5]), np.array([1., 3., 0., 4.]))
+        self.assertAlmostEqual(m['mean'], stats.mean(h))
+        self.assertAlmostEqual(m['mean'], stats.expectation(h, 1))
+        self.assertAlmostEqual(m['var'], stats.var(h))
+        self.assertAlmostEqual(m['std'], stats.std(h))
+        self.assertAlmostEqual(m['skewness'], stats.skewness(h))
+        self.assertAlmostEqual(m['kurtosis'], stats.kurtosis(h))
+        self.assertAlmostEqual(m['excess'], stats.excess(h))
+
+    def test_moments_2d(self):
+        """Tests if the moments function returns a dictionary for each axis of
+        a 2-dimensional histogram, and if it matches the mean function.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0, 4, 1),
+                           ndhist.axes.linear(0, 2, 0.5)))
+        h.fill(([0.5, 1.5, 3.5, 3.5], [0.25, 1.75, 1.25, 1.25]), [1, 2, 3, 4])
+
+        ms = stats.moments(h)
+        self.assertTrue(len(ms) == 2)
+        self.assert_moments(ms[0],
+            np.array([0.5, 1.5, 3.5]), np.array([1., 2., 7.]))
+        self.assert_moments(ms[1],
+            np.array([0.25, 1.25, 1.75]), np.array([1., 7., 2.]))
+
+        means = stats.mean(h)
+        self.assertTrue(len(means) == 2)
+        for i in range(2):
+            self.assertAlmostEqual(ms[i]['mean'], means[i])
+            self.assertAlmostEqual(stats.moments(h, axis=i)['mean'], stats.mean(h, axis=i))
+
+if(__name__ == "__main__"):
+    unittest.main()
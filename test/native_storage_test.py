@@ -0,0 +1,141 @@
+import os
+import shutil
+import struct
+import tempfile
+import unittest
+
+import numpy as np
+import ndhist
+from ndhist import storage
+
+class Test(unittest.TestCase):
+    def setUp(self):
+        self.tmpdir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.tmpdir)
+
+    def assert_equal_hists(self, h1, h2):
+        self.assertTrue(h1.title == h2.title)
+        self.assertTrue(h1.shape == h2.shape)
+        self.assertTrue(h1.weight_dtype == h2.weight_dtype)
+        for (a1, a2) in zip(h1.axes, h2.axes):
+            self.assertTrue(a1.__class__ == a2.__class__)
+            self.assertTrue(a1.name == a2.name)
+            self.assertTrue(a1.is_extendable == a2.is_extendable)
+            self.assertTrue(np.all(a1.binedges == a2.binedges))
+        self.assertTrue(np.all(h1.full_binentries == h2.full_binentries))
+        self.assertTrue(np.all(h1.full_bincontent == h2.full_bincontent))
+        self.assertTrue(np.all(h1.full_squaredweights == h2.full_squaredweights))
+
+    def test_native_storage_roundtrip(self):
+        """Tests if a histogram can be saved to and loaded from a native
+        ndhist file.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,10, name='x'),
+                           ndhist.axes.log10(1,1000, 0.5, name='y'),
+                           ndhist.axes.category([1,2,3], name='c')
+                          ), dtype=np.float64)
+        h.title = 'native'
+        h.fill(([-1,0.5,3,3,11], [0.5,2,20,200,2000], [1,2,3,3,7]), [1,2,3,4,5])
+
+        fn = os.path.join(self.tmpdir, 'h.ndh')
+        storage.histsave(h, fn)
+        h2 = storage.histload(fn)
+        self.assert_equal_hists(h, h2)
+
+        # The loaded histogram must be fillable, without changing the file.
+        h2.fill(([3], [20], [1]))
+        self.assertTrue(np.sum(h2.full_binentries) == np.sum(h.full_binentries) + 1)
+        h3 = storage.histload(fn)
+        self.assert_equal_hists(h, h3)
+
+    def test_native_storage_extended_axis(self):
+        """Tests if a histogram with an extended axis can be saved to and loaded
+        from a native ndhist file, and can still be extended afterwards.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4, extend=True, extracap=2),))
+        h.fill(([-1,0,5],))
+        self.assertTrue(h.nbins == (6,))
+
+        fn = os.path.join(self.tmpdir, 'ext.ndh')
+        storage.histsave(h, fn)
+        h2 = storage.histload(fn)
+        self.assert_equal_hists(h, h2)
+
+        h2.fill(([10],))
+        self.assertTrue(h2.nbins == (11,))
+        self.assertTrue(np.all(h2.binentries[:6] == h.binentries))
+
+    def test_native_storage_view(self):
+        """Tests if a histogram view is stored with its own bin content.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,10),))
+        h.fill(([0,1,2,3,4,5,6,7,8,9],))
+        hv = h[2:5]
+        self.assertTrue(hv.is_view)
+
+        fn = os.path.join(self.tmpdir, 'view.ndh')
+        storage.histsave(hv, fn)
+        h2 = storage.histload(fn)
+        self.assertFalse(h2.is_view)
+        self.assertTrue(np.all(h2.binentries == hv.binentries))
+
+    def test_native_storage_readonly(self):
+        """Tests if a histogram loaded in read-only mode cannot be altered, but
+        its deepcopy can.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,10),))
+        h.fill(([0,1,1,2],))
+        fn = os.path.join(self.tmpdir, 'ro.ndh')
+        storage.histsave(h, fn)
+
+        h2 = storage.histload(fn, mode='r')
+        self.assertTrue(h2.is_readonly)
+        self.assertFalse(h2.bincontent.flags.writeable)
+        self.assertTrue(np.all(h2.bincontent == h.bincontent))
+        self.assertTrue(np.all(h2[1:3].bincontent == h.bincontent[1:3]))
+        with self.assertRaises(ValueError):
+            h2.fill(([1],))
+        with self.assertRaises(ValueError):
+            h2.clear()
+
+        h3 = h2.deepcopy()
+        self.assertFalse(h3.is_readonly)
+        h3.fill(([1],))
+        self.assertTrue(h3.bincontent[1] == 3)
+        self.assertTrue(h2.bincontent[1] == 2)
+
+        h4 = storage.histload(fn, mode='c')
+        self.assertFalse(h4.is_readonly)
+
+    def test_native_storage_inconsistent_shape(self):
+        """Tests if loading a native ndhist file, whose stored shape does not
+        match the number of bins of its axes, raises a ValueError, even if the
+        total size of the bin content block is consistent.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4),
+                           ndhist.axes.linear(0,2)))
+        self.assertTrue(h.shape == (6,4))
+        fn = os.path.join(self.tmpdir, 'shape.ndh')
+        storage.histsave(h, fn)
+
+        # Permute the stored shape (6,4) into (4,6).
+        with open(fn, 'rb') as fp:
+            data = fp.read()
+        old = struct.pack('=qqqqqq', 6,0,0, 4,0,0)
+        new = struct.pack('=qqqqqq', 4,0,0, 6,0,0)
+        self.assertTrue(data.count(old) == 1)
+        with open(fn, 'wb') as fp:
+            fp.write(data.replace(old, new))
+
+        with self.assertRaises(ValueError):
+            storage.histload(fn)
+
+if(__name__ == "__main__"):
+    unittest.main()
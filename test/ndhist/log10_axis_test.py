@@ -22,5 +22,51 @@ class Test(unittest.TestCase):
             0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,  0.,
             0.,  0.,  0.,  1.])))
 
+    def test_log10_axis_chunked_fill(self):
+        """Tests if filling many values, whose bins are searched in chunks,
+        gives the bin indices of the scalar bin search of the axis.
+
+        """
+        axis_0 = ndhist.axes.log10(0.1, 100, 0.1)
+        h = ndhist.ndhist((axis_0,))
+        rng = np.random.RandomState(1)
+        values = 10**rng.uniform(-1.5, 2.5, 1000)
+
+        # Add the values, for which the approximate batched log10 transform
+        # needs the exact fix-up: the exact bin edges and their neighbouring
+        # floating point values, and values outside of the domain of the
+        # approximation.
+        edges = axis_0.binedges
+        values = np.concatenate((
+            values,
+            edges,
+            np.nextafter(edges, 0),
+            np.nextafter(edges, np.inf),
+            [0., -0., -1., -100., np.inf, 1e-320, 1e308]))
+        rng.shuffle(values)
+        h.fill(values)
+
+        # Compare with the scalar bin search, which is used for single
+        # values.
+        h1 = ndhist.ndhist((ndhist.axes.log10(0.1, 100, 0.1),))
+        for v in values:
+            h1.fill([v])
+        self.assertTrue(np.all(h.full_bincontent == h1.full_bincontent))
+
+    def test_extension_within_chunk(self):
+        """Tests if values, that follow an axis extension within the same
+        chunk of values, are filled into the right bins.
+
+        """
+        values = np.concatenate(([-3.5], np.arange(-2.5, 5, 1.)))
+        h1 = ndhist.ndhist((ndhist.axes.linear(0, 4, extend=True, extracap=10),))
+        h1.fill(values)
+        h2 = ndhist.ndhist((ndhist.axes.linear(0, 4, extend=True, extracap=10),))
+        for v in values:
+            h2.fill([v])
+        self.assertTrue(h1.nbins == h2.nbins)
+        self.assertTrue(np.all(h1.binentries == h2.binentries))
+        self.assertTrue(np.all(h1.binentries == 1))
+
 if(__name__ == "__main__"):
     unittest.main()
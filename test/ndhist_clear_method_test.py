@@ -38,5 +38,23 @@ class Test(unittest.TestCase):
             [ 1.,  1.,  0.,  0.,  0.,  1.,  1.,  1.,  1.,  1.]
         )))
 
+    def test_ndhist_clear_method_2D_view(self):
+        """Tests if the clear method of a 2D data view clears only the bins of
+        the view.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,10), ndhist.axes.linear(0,5)))
+        h.fill((np.repeat(np.arange(10), 5), np.tile(np.arange(5), 10)))
+        self.assertTrue(np.all(h.bincontent == 1))
+
+        h2 = h[3:6,1:3]
+        self.assertTrue(h2.shape == (3,2))
+        h2.clear()
+        self.assertTrue(np.all(h2.bincontent == 0))
+
+        expected = np.ones((10,5))
+        expected[2:5,0:2] = 0
+        self.assertTrue(np.all(h.bincontent == expected))
+
 if(__name__ == "__main__"):
     unittest.main()
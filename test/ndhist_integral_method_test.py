@@ -0,0 +1,44 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_ndhist_integral_method_2D(self):
+        """Tests if the integral method of the ndhist class gives the same sums
+        as summing the bin content array slices.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,10), ndhist.axes.linear(0,5)))
+        np.random.seed(42)
+        h.fill((np.random.uniform(-1,11,1000), np.random.uniform(-1,6,1000)),
+               np.random.uniform(0,2,1000))
+
+        self.assertAlmostEqual(h.integral(), np.sum(h.bincontent))
+        for ((x0,x1),(y0,y1)) in [((0,10),(0,5)), ((2,7),(1,3)), ((3,3),(0,5)), ((9,10),(4,5))]:
+            self.assertAlmostEqual(h.integral(((x0,x1),(y0,y1))), np.sum(h.bincontent[x0:x1,y0:y1]))
+            (noe, sow, sows) = h.integral_sums(((x0,x1),(y0,y1)))
+            self.assertAlmostEqual(noe, np.sum(h.binentries[x0:x1,y0:y1]))
+            self.assertAlmostEqual(sow, np.sum(h.bincontent[x0:x1,y0:y1]))
+            self.assertAlmostEqual(sows, np.sum(h.squaredweights[x0:x1,y0:y1]))
+        self.assertAlmostEqual(h.integral((None,(1,3))), np.sum(h.bincontent[:,1:3]))
+
+        with self.assertRaises(IndexError):
+            h.integral(((0,11),(0,5)))
+
+    def test_ndhist_integral_method_invalidation(self):
+        """Tests if the summed-area table is recalculated after the histogram
+        has been modified.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4),))
+        h.fill(([0,1,2],))
+        self.assertTrue(h.integral(((0,2),)) == 2)
+        h.fill(([1,3],))
+        self.assertTrue(h.integral(((0,2),)) == 3)
+        self.assertTrue(h.integral() == 5)
+        h.clear()
+        self.assertTrue(h.integral() == 0)
+
+if(__name__ == "__main__"):
+    unittest.main()
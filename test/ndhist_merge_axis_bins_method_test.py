@@ -183,5 +183,58 @@ class Test(unittest.TestCase):
              [ 2.]]
         )))
 
+    def test_ndhist_merge_bins_method_2D(self):
+        """Tests if the merge_bins method of the ndhist class, which merges
+        the bins of several axes at once, gives the same result as merging the
+        bins of one axis after the other.
+
+        """
+        axis_0 = ndhist.axes.linear(0,10)
+        axis_1 = ndhist.axes.linear(0,5, add_overflow_bin=False)
+
+        h = ndhist.ndhist((axis_0,axis_1))
+        h.fill(([0,1,2,3,4,5,6, 7,   8,9,10,10,10],
+                [0,1,2,3,4,4,5,-1,-0.2,5, 6, 0, 1]))
+
+        h2 = h.merge_bins((0,1), (3,2), copy=True)
+        h3 = h.merge_axis_bins(0, 3, copy=True).merge_axis_bins(1, 2, copy=False)
+        self.assertFalse(h2.is_view)
+        self.assertTrue(h2.shape == (5,4))
+        self.assertTrue(h2.nbins == (3,2))
+        self.assertTrue(h2.shape == h3.shape)
+        self.assertTrue(np.all(h2.axes[0].binedges == h3.axes[0].binedges))
+        self.assertTrue(np.all(h2.axes[1].binedges == np.array([-np.inf,0,2,4,5])))
+        self.assertTrue(np.all(h2.bincontent == h3.bincontent))
+        self.assertTrue(np.all(h2.underflow[0] == h3.underflow[0]))
+        self.assertTrue(np.all(h2.underflow[1] == h3.underflow[1]))
+        self.assertTrue(np.all(h2.overflow[0] == h3.overflow[0]))
+        self.assertTrue(np.all(h2.overflow[1] == h3.overflow[1]))
+
+        # The original histogram must not be changed by the copy.
+        self.assertTrue(h.shape == (12,6))
+
+        # Merge the bins of the original histogram in-place.
+        h4 = h.merge_bins((0,-1), (3,2), copy=False)
+        self.assertTrue(h4.shape == (5,4))
+        self.assertTrue(np.all(h4.bincontent == h3.bincontent))
+
+    def test_ndhist_merge_bins_method_category_axis(self):
+        """Tests if merging the bins of a category axis is rejected without
+        altering the histogram.
+
+        """
+        axis_0 = ndhist.axes.linear(0,10)
+        axis_1 = ndhist.axes.category([1, 2, 3])
+
+        h = ndhist.ndhist((axis_0,axis_1))
+        h.fill(([0,1,2,3], [1,2,3,2]))
+        bc = h.bincontent.copy()
+
+        self.assertRaises(TypeError, h.merge_bins, (0,1), (2,2), copy=False)
+        self.assertRaises(TypeError, h.merge_axis_bins, 1, 2, copy=False)
+        self.assertTrue(h.shape == (12,4))
+        self.assertTrue(h.nbins == (10,3))
+        self.assertTrue(np.all(h.bincontent == bc))
+
 if(__name__ == "__main__"):
     unittest.main()
@@ -0,0 +1,114 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_ndhist_rebin_to_method_aligned_edges(self):
+        """Tests if the rebin_to method of the ndhist class works properly for
+        new edges, which are aligned with the old edges.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4),))
+        h.fill(([-1,0,1,2,3,3.5,5],))
+
+        h2 = h.rebin_to(0, [0,2,4])
+        self.assertFalse(h2.is_view)
+        self.assertTrue(h2.shape == (4,))
+        self.assertTrue(h2.nbins == (2,))
+        self.assertTrue(np.all(h2.axes[0].binedges == np.array([-np.inf,0,2,4,+np.inf])))
+        self.assertTrue(np.all(h2.full_bincontent == np.array([1,2,3,1])))
+        self.assertTrue(np.all(h2.full_binentries == np.array([1,2,3,1])))
+
+        # The original histogram must not be changed by the copy.
+        self.assertTrue(h.shape == (6,))
+
+        # Old bins outside of the new range go into the under- and overflow
+        # bins.
+        h3 = h.rebin_to(0, [1,3])
+        self.assertTrue(np.all(h3.axes[0].binedges == np.array([-np.inf,1,3,+np.inf])))
+        self.assertTrue(np.all(h3.full_bincontent == np.array([2,2,3])))
+
+        # Unaligned new edges require the splitting of old bins.
+        with self.assertRaises(ValueError):
+            h.rebin_to(0, [0.5,2])
+
+    def test_ndhist_rebin_to_method_split(self):
+        """Tests if the rebin_to method of the ndhist class splits the old bins
+        proportional to the overlapping lengths.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4, add_underflow_bin=False, add_overflow_bin=False),))
+        h.fill(([0.5,0.5,0.5,0.5,1.5],))
+
+        h2 = h.rebin_to(0, [0.5,4], split=True)
+        self.assertTrue(h2.axes[0].has_underflow_bin)
+        self.assertFalse(h2.axes[0].has_overflow_bin)
+        self.assertTrue(np.all(h2.axes[0].binedges == np.array([0,0.5,4])))
+        self.assertTrue(np.all(h2.full_bincontent == np.array([2,3])))
+        self.assertTrue(np.all(h2.full_binentries == np.array([2,3])))
+
+    def test_ndhist_rebin_to_method_2D(self):
+        """Tests if the rebin_to method of the ndhist class gives the same
+        result as merging the bins, when the new edges correspond to merged
+        bins.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,10), ndhist.axes.linear(0,5)))
+        h.fill(([0,1,2,3,4,5,6, 7,   8,9,10,10,10],
+                [0,1,2,3,4,4,5,-1,-0.2,5, 6, 0, 1]))
+
+        h2 = h.rebin_to(1, [0,2,4])
+        h3 = h.merge_axis_bins(1, 2)
+        self.assertTrue(h2.shape == h3.shape)
+        self.assertTrue(np.all(h2.full_bincontent == h3.full_bincontent))
+
+        # Rebin the original histogram in-place.
+        h4 = h.rebin_to(-1, [0,2,4], copy=False)
+        self.assertTrue(h.shape == h3.shape)
+        self.assertTrue(np.all(h4.full_bincontent == h3.full_bincontent))
+
+    def test_ndhist_rebin_to_method_integer_axis(self):
+        """Tests if the rebin_to method keeps the data type of an integer axis,
+        and if it raises a ValueError for new edges, which are not integral.
+
+        """
+        edges = np.array([-100,0,2,4,6,8,100], dtype=np.int64)
+        h = ndhist.ndhist((ndhist.core.generic_axis(edges),))
+        h.fill((np.array([-5,1,3,3,5,7,50], dtype=np.int64),))
+
+        h2 = h.rebin_to(0, [0,4,8])
+        self.assertTrue(h2.axes[0].binedges.dtype == np.int64)
+        self.assertTrue(np.all(h2.axes[0].binedges == np.array([-100,0,4,8,100])))
+        self.assertTrue(np.all(h2.full_bincontent == np.array([1,3,2,1])))
+
+        with self.assertRaises(ValueError):
+            h.rebin_to(0, [0,2.5,8], split=True)
+
+    def test_ndhist_rebin_to_method_profile(self):
+        """Tests if the rebin_to method of the ndhist class rebins the profile
+        sums of a profile histogram together with the other bin content
+        values.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0,4),), profile=True)
+        h.fill(([0.5,1.5,2.5,3.5], [1.,2.,3.,4.]), [1.,1.,2.,1.])
+
+        h2 = h.rebin_to(0, [0,2,4])
+        self.assertTrue(np.all(h2.bincontent == np.array([2.,3.])))
+        self.assertTrue(np.all(h2.profile_sum == np.array([3.,10.])))
+        self.assertTrue(np.all(h2.profile_squaredsum == np.array([5.,34.])))
+
+    def test_ndhist_rebin_to_method_category_axis(self):
+        """Tests if the rebin_to method of the ndhist class rejects category
+        axes.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.category([1,2,3]),))
+        h.fill(([1,2,3],))
+        with self.assertRaises(TypeError):
+            h.rebin_to(0, [0,2,3])
+        self.assertTrue(h.nbins == (3,))
+
+if(__name__ == "__main__"):
+    unittest.main()
@@ -0,0 +1,70 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_profile_fill(self):
+        """Tests if a profile histogram is filled properly with the extra
+        profile value column.
+
+        """
+        axis_0 = ndhist.axes.linear(0, 3, 1)
+
+        h = ndhist.ndhist((axis_0,), profile=True)
+        self.assertTrue(h.is_profile)
+
+        # Fill the profile values y into the bins [0, 0, 1, 1].
+        h.fill(([0.5, 0.5, 1.5, 1.5], [1., 3., 2., 2.]), [1., 1., 1., 3.])
+        self.assertTrue(np.all(h.binentries == np.array([2, 2, 0])))
+        self.assertTrue(np.all(h.bincontent == np.array([2., 4., 0.])))
+        self.assertTrue(np.all(h.profile_sum == np.array([4., 8., 0.])))
+        self.assertTrue(np.all(h.profile_squaredsum == np.array([10., 16., 0.])))
+
+        mean = h.profile_mean
+        self.assertTrue(np.all(mean[:2] == np.array([2., 2.])))
+        self.assertTrue(np.isnan(mean[2]))
+
+        std = h.profile_std
+        self.assertTrue(np.all(std[:2] == np.array([1., 0.])))
+        self.assertTrue(np.isnan(std[2]))
+
+        # A profile histogram requires the extra profile value column.
+        self.assertRaises(ValueError, h.fill, ([0.5],))
+
+        # A profile histogram requires a floating point weight type.
+        self.assertRaises(TypeError, ndhist.ndhist, (axis_0,),
+            dtype=np.int64, profile=True)
+
+    def test_profile_arithmetic(self):
+        """Tests if the profile sums are added, scaled, and cleared together
+        with the other bin content values.
+
+        """
+        axis_0 = ndhist.axes.linear(0, 3, 1)
+
+        h1 = ndhist.ndhist((axis_0,), profile=True)
+        h1.fill(([0.5, 1.5], [1., 2.]))
+        h2 = h1.empty_like()
+        self.assertTrue(h2.is_profile)
+        h2.fill(([0.5, 2.5], [3., 4.]))
+
+        h1 += h2
+        self.assertTrue(np.all(h1.profile_sum == np.array([4., 2., 4.])))
+        self.assertTrue(np.all(h1.profile_mean == np.array([2., 2., 4.])))
+
+        h1 *= 2
+        self.assertTrue(np.all(h1.profile_sum == np.array([8., 4., 8.])))
+        self.assertTrue(np.all(h1.profile_mean == np.array([2., 2., 4.])))
+
+        h1.clear()
+        self.assertTrue(np.all(h1.profile_sum == 0))
+        self.assertTrue(np.all(h1.profile_squaredsum == 0))
+
+        # The profile properties are only defined for profile histograms.
+        h3 = ndhist.ndhist((axis_0,))
+        self.assertFalse(h3.is_profile)
+        self.assertRaises(TypeError, lambda: h3.profile_mean)
+
+if(__name__ == "__main__"):
+    unittest.main()
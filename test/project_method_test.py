@@ -37,5 +37,63 @@ class Test(unittest.TestCase):
         self.assertTrue(p1.bincontent[1] == 1)
         self.assertTrue(p1.bincontent[2] == 6)
 
+    def test_project_many_method(self):
+        """Tests if the project_many method of the ndhist class gives the same
+        results as the project method.
+
+        """
+        axis_0 = ndhist.axes.linear(-2, 3, 1)
+        axis_1 = ndhist.axes.linear(-1, 2, 1)
+        axis_2 = ndhist.axes.linear(0, 4, 2)
+
+        h = ndhist.ndhist((axis_0, axis_1, axis_2))
+        h.fill(([-1, -0.5, 0, 0, 2.5], [1, 1.1, 0, 1.3, -0.5], [0, 1, 2, 3, 3]), [1, 2, 1, 3, 4])
+
+        dims_seq = [(0,), (1,), (0,2), (2,1)]
+        projs = h.project_many(dims_seq)
+        self.assertTrue(len(projs) == len(dims_seq))
+        for (dims, p) in zip(dims_seq, projs):
+            pref = h.project(dims)
+            self.assertTrue(p.nbins == pref.nbins)
+            self.assertTrue(np.all(p.full_binentries == pref.full_binentries))
+            self.assertTrue(np.all(p.full_bincontent == pref.full_bincontent))
+            self.assertTrue(np.all(p.full_squaredweights == pref.full_squaredweights))
+
+    def test_projection_cache(self):
+        """Tests if cached projections get invalidated when the histogram gets
+        modified.
+
+        """
+        axis_0 = ndhist.axes.linear(-2, 3, 1)
+        axis_1 = ndhist.axes.linear(-1, 2, 1)
+
+        h = ndhist.ndhist((axis_0, axis_1))
+        count = h.modification_count
+        h.fill((-1, 1))
+        self.assertTrue(h.modification_count > count)
+
+        p0 = h.project(0)
+        self.assertTrue(p0.bincontent[1] == 1)
+
+        # Altering the returned projection must not alter the cache.
+        self.assertFalse(p0.is_readonly)
+        p0.clear()
+        self.assertTrue(h.project(0).bincontent[1] == 1)
+
+        # Writes through the bin content ndarray must invalidate the cache.
+        count = h.modification_count
+        bc = h.bincontent
+        self.assertTrue(h.modification_count > count)
+        bc[1,2] = 4
+        self.assertTrue(h.project(0).bincontent[1] == 4)
+        h.bincontent[1,2] = 1
+        self.assertTrue(h.project(0).bincontent[1] == 1)
+
+        h.fill((-1, 1), 2)
+        self.assertTrue(h.project(0).bincontent[1] == 3)
+
+        h.clear()
+        self.assertTrue(np.all(h.project(0).bincontent == 0))
+
 if(__name__ == "__main__"):
     unittest.main()
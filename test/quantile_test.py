@@ -0,0 +1,99 @@
+import unittest
+
+import numpy as np
+import ndhist
+from ndhist import stats
+
+class Test(unittest.TestCase):
+    def setUp(self):
+        # The cumulative sum of weights of the four bins is [1, 4, 4, 8]. The
+        # under- and overflow bins must not contribute.
+        self.h = ndhist.ndhist((ndhist.axes.linear(0, 4, 1),))
+        self.h.fill([-1, 0.5, 1.5, 1.5, 3.5, 10], [100, 1, 2, 1, 4, 100])
+
+    def test_quantile_bin_center(self):
+        """Tests the quantile values without interpolation, which are the bin
+        centers, or the upper bin edges if the quantile coincides with them.
+
+        """
+        h = self.h
+        self.assertAlmostEqual(stats.quantile(h, 0.25), 1.5)
+        self.assertAlmostEqual(stats.quantile(h, 0.5), 2.0)
+        self.assertAlmostEqual(stats.quantile(h, 0.75), 3.5)
+        self.assertAlmostEqual(stats.quantile(h, 0.5), stats.median(h))
+
+        qs = stats.quantile(h, [0.25, 0.5, 0.75])
+        self.assertTrue(isinstance(qs, np.ndarray))
+        self.assertTrue(np.allclose(qs, [1.5, 2.0, 3.5]))
+
+    def test_quantile_interpolation(self):
+        """Tests the linear interpolation of the quantile values within a bin.
+
+        """
+        h = self.h
+        self.assertAlmostEqual(stats.quantile(h, 0.25, interpolate=True), 1 + 1./3)
+        self.assertAlmostEqual(stats.quantile(h, 0.5, interpolate=True), 2.0)
+        self.assertAlmostEqual(stats.quantile(h, 0.75, interpolate=True), 3.5)
+        self.assertAlmostEqual(stats.quantile(h, 0.1, interpolate=True), 0.8)
+
+    def test_quantile_limits(self):
+        """Tests the quantile values for q=0 and q=1, which are the beginning
+        of the first and the end of the last non-empty bin, respectively.
+
+        """
+        h = self.h
+        self.assertAlmostEqual(stats.quantile(h, 0), 0.5)
+        self.assertAlmostEqual(stats.quantile(h, 1), 4.0)
+        self.assertAlmostEqual(stats.quantile(h, 0, interpolate=True), 0.0)
+        self.assertAlmostEqual(stats.quantile(h, 1, interpolate=True), 4.0)
+
+        # Leading empty bins are skipped for q=0.
+        h2 = ndhist.ndhist((ndhist.axes.linear(0, 4, 1),))
+        h2.fill([2.5, 3.5])
+        self.assertAlmostEqual(stats.quantile(h2, 0), 2.5)
+        self.assertAlmostEqual(stats.quantile(h2, 0, interpolate=True), 2.0)
+
+        self.assertRaises(ValueError, stats.quantile, h, -0.1)
+        self.assertRaises(ValueError, stats.quantile, h, 1.1)
+
+    def test_quantile_all_zero(self):
+        """Tests if the quantile of an empty histogram, or of a histogram
+        filled only in its under- and overflow bins, raises a ValueError.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0, 4, 1),))
+        self.assertRaises(ValueError, stats.quantile, h, 0.5)
+        h.fill([-1, 10])
+        self.assertRaises(ValueError, stats.quantile, h, 0.5)
+
+    def test_quantile_2d(self):
+        """Tests if the quantiles of all the axes are returned as a tuple for
+        a 2-dimensional histogram.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0, 4, 1),
+                           ndhist.axes.linear(0, 2, 0.5)))
+        h.fill(([0.5, 1.5, 3.5, 3.5], [0.25, 1.75, 1.25, 1.25]), [1, 2, 3, 4])
+        qs = stats.quantile(h, 0.5)
+        self.assertTrue(len(qs) == 2)
+        self.assertAlmostEqual(qs[0], 3.5)
+        self.assertAlmostEqual(qs[1], 1.25)
+        self.assertAlmostEqual(stats.quantile(h, 0.5, axis=1), 1.25)
+
+    def test_quantile_integer_axis(self):
+        """Tests that the quantile values of an integer axis are not
+        truncated, and that the quantile ndarray has the float64 data type.
+
+        """
+        edges = np.array([0,2,4,6], dtype=np.int64)
+        h = ndhist.ndhist((ndhist.core.generic_axis(edges),))
+        h.fill((np.array([1,3,3,5], dtype=np.int64),))
+        self.assertAlmostEqual(stats.quantile(h, 0.125, interpolate=True), 1.0)
+        self.assertAlmostEqual(stats.quantile(h, 0.375, interpolate=True), 2.5)
+
+        qs = stats.quantile(h, [0.125, 0.375], interpolate=True)
+        self.assertTrue(qs.dtype == np.float64)
+        self.assertTrue(np.allclose(qs, [1.0, 2.5]))
+
+if(__name__ == "__main__"):
+    unittest.main()
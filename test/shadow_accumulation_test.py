@@ -0,0 +1,78 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_shadow_accumulation(self):
+        """Tests if filling with shadow accumulation gives the same result as
+        filling without it, for integer weights, for which the float32 sums are
+        exact.
+
+        """
+        n = 10000
+        x = np.linspace(-1, 11, n)
+        w = (np.arange(n) % 5).astype(np.float64)
+
+        h1 = ndhist.ndhist((ndhist.axes.linear(0, 10, 0.5),))
+        self.assertFalse(h1.shadow_accumulation)
+        h1.fill(x, w)
+
+        h2 = ndhist.ndhist((ndhist.axes.linear(0, 10, 0.5),))
+        h2.shadow_accumulation = True
+        self.assertTrue(h2.shadow_accumulation)
+        h2.fill(x, w)
+        h2.fill(x[::2], w[::2])
+        h1.fill(x[::2], w[::2])
+
+        self.assertTrue(np.all(h1.binentries == h2.binentries))
+        self.assertTrue(np.all(h1.bincontent == h2.bincontent))
+        self.assertTrue(np.all(h1.squaredweights == h2.squaredweights))
+        self.assertTrue(h1.underflow_entries == h2.underflow_entries)
+        self.assertTrue(h1.overflow_entries == h2.overflow_entries)
+
+    def test_shadow_accumulation_with_extension(self):
+        """Tests if the shadow accumulation handles the extension of an axis
+        during a fill.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0, 4, extend=True, extracap=1),))
+        h.shadow_accumulation = True
+        h.fill([0.5, 1.5, -1.5, 5.5, 0.5], [1, 2, 3, 4, 5])
+        self.assertTrue(h.nbins == (8,))
+        self.assertTrue(np.all(h.binentries == np.array([1,0,2,1,0,0,0,1])))
+        self.assertTrue(np.all(h.bincontent == np.array([3,0,6,2,0,0,0,4])))
+
+    def test_shadow_accumulation_single_bin(self):
+        """Tests if the shadow record of a bin, which gets more entries than
+        the flush interval, is added to the bin content array in time, and if
+        a deep copy does not share the shadow accumulator.
+
+        """
+        n = 20000
+        h = ndhist.ndhist((ndhist.axes.linear(0, 2, 1),))
+        h.shadow_accumulation = True
+        h.fill(np.repeat(0.5, n), 3)
+        self.assertTrue(np.all(h.binentries == np.array([n, 0])))
+        self.assertTrue(np.all(h.bincontent == np.array([3*n, 0])))
+        self.assertTrue(np.all(h.squaredweights == np.array([9*n, 0])))
+
+        h2 = h.deepcopy()
+        h2.fill(np.repeat(1.5, n), 1)
+        h.fill([0.5])
+        self.assertTrue(np.all(h.binentries == np.array([n+1, 0])))
+        self.assertTrue(np.all(h2.binentries == np.array([n, n])))
+        self.assertTrue(np.all(h2.bincontent == np.array([3*n, n])))
+
+    def test_shadow_accumulation_not_supported(self):
+        """Tests if enabling the shadow accumulation fails for histograms with
+        a weight type other than float64.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0, 10, 1),), dtype=np.int64)
+        def _enable():
+            h.shadow_accumulation = True
+        self.assertRaises(TypeError, _enable)
+
+if(__name__ == "__main__"):
+    unittest.main()
@@ -31,5 +31,43 @@ class Test(unittest.TestCase):
         self.assertTrue(h.squaredweights[2,1] == 1)
 
 
+    def test_tuple_fill_with_conversion_chunks(self):
+        """Tests if filling large value arrays, whose data type differs from the
+        data type of the axes, gives the same result as filling value arrays of
+        the data type of the axes.
+
+        """
+        n = 200000
+        x = np.linspace(-2, 3, n, endpoint=False)
+        y = np.linspace(-1, 2, n, endpoint=False)[::-1]
+        w = np.arange(n) % 3
+
+        h1 = ndhist.ndhist((ndhist.axes.linear(-2, 3, 0.5),
+                            ndhist.axes.linear(-1, 2, 0.5)))
+        h1.fill((x, y), w.astype(np.float64))
+
+        h2 = ndhist.ndhist((ndhist.axes.linear(-2, 3, 0.5),
+                            ndhist.axes.linear(-1, 2, 0.5)))
+        h2.fill((x.astype(np.float32), y.astype(np.float32)), w)
+
+        # Compute the expected results with the same float32 values.
+        h3 = ndhist.ndhist((ndhist.axes.linear(-2, 3, 0.5),
+                            ndhist.axes.linear(-1, 2, 0.5)))
+        h3.fill((x.astype(np.float32).astype(np.float64),
+                 y.astype(np.float32).astype(np.float64)), w.astype(np.float64))
+        self.assertTrue(np.all(h2.binentries == h3.binentries))
+        self.assertTrue(np.all(h2.bincontent == h3.bincontent))
+        self.assertTrue(np.all(h2.squaredweights == h3.squaredweights))
+        self.assertTrue(np.sum(h2.binentries) == n)
+        self.assertTrue(np.sum(h1.bincontent) == np.sum(h2.bincontent))
+
+        # A scalar weight is used for all the chunks.
+        h4 = ndhist.ndhist((ndhist.axes.linear(-2, 3, 0.5),
+                            ndhist.axes.linear(-1, 2, 0.5)))
+        h4.fill((x.astype(np.float32), y.astype(np.float32)), 2)
+        self.assertTrue(np.all(h4.binentries == h3.binentries))
+        self.assertTrue(np.all(h4.bincontent == 2*h3.binentries))
+
+
 if(__name__ == "__main__"):
     unittest.main()
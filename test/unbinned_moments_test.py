@@ -0,0 +1,65 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_unbinned_moments(self):
+        """Tests if the unbinned moments are tracked during filling, merged by
+        the += operator, and reset by the clear method.
+
+        """
+        axis_0 = ndhist.axes.linear(0, 10, 1)
+
+        h = ndhist.ndhist((axis_0,))
+        self.assertFalse(h.track_unbinned_moments)
+        h.track_unbinned_moments = True
+        self.assertTrue(h.track_unbinned_moments)
+
+        h.fill([0.1, 0.2, 2.7], [1., 1., 2.])
+        (sow, sum_wx, sum_wx2) = h.get_unbinned_sums(0)
+        self.assertAlmostEqual(sow, 4.)
+        self.assertAlmostEqual(sum_wx, 5.7)
+        self.assertAlmostEqual(sum_wx2, 0.01 + 0.04 + 2*7.29)
+        self.assertAlmostEqual(h.get_unbinned_mean(), 5.7/4.)
+        self.assertAlmostEqual(h.get_unbinned_var(), (0.01 + 0.04 + 2*7.29)/4. - (5.7/4.)**2)
+
+        h2 = h.empty_like()
+        self.assertTrue(h2.track_unbinned_moments)
+        h2.fill([5.3])
+        h += h2
+        (sow, sum_wx, sum_wx2) = h.get_unbinned_sums(0)
+        self.assertAlmostEqual(sow, 5.)
+        self.assertAlmostEqual(sum_wx, 11.)
+        self.assertAlmostEqual(h.get_unbinned_mean(), 11./5.)
+
+        h.clear()
+        (sow, sum_wx, sum_wx2) = h.get_unbinned_sums(0)
+        self.assertTrue(sow == 0)
+        self.assertTrue(sum_wx == 0)
+
+        h.track_unbinned_moments = False
+        self.assertRaises(AssertionError, h.get_unbinned_mean)
+
+    def test_unbinned_moments_cancelling_weights(self):
+        """Tests that the unbinned moments stay finite, when the sum of weights
+        cancels to zero.
+
+        """
+        h = ndhist.ndhist((ndhist.axes.linear(0, 10, 1),))
+        h.track_unbinned_moments = True
+        h.fill([1., 3.], [1., -1.])
+        (sow, sum_wx, sum_wx2) = h.get_unbinned_sums(0)
+        self.assertTrue(sow == 0)
+        self.assertTrue(np.isfinite(sum_wx))
+        self.assertAlmostEqual(sum_wx2, 1. - 9.)
+        self.assertTrue(np.isfinite(h.get_unbinned_mean()))
+
+        h.fill([2.], [2.])
+        (sow, sum_wx, sum_wx2) = h.get_unbinned_sums(0)
+        self.assertAlmostEqual(sow, 2.)
+        self.assertAlmostEqual(sum_wx2, 1. - 9. + 8.)
+        self.assertTrue(np.isfinite(h.get_unbinned_mean()))
+
+if(__name__ == "__main__"):
+    unittest.main()
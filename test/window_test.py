@@ -0,0 +1,80 @@
+import unittest
+
+import numpy as np
+import ndhist
+
+class Test(unittest.TestCase):
+    def test_isub_operator(self):
+        """Tests if the -= operator subtracts the bin contents of a
+        previously added histogram.
+
+        """
+        h1 = ndhist.ndhist((ndhist.axes.linear(0, 10, 1),))
+        h1.fill([0.5, 1.5, 1.5], [1, 2, 3])
+        h2 = h1.empty_like()
+        h2.fill([1.5, 4.5], [2, 4])
+
+        h = h1.empty_like()
+        h += h1
+        h += h2
+        h -= h2
+        self.assertTrue(np.all(h.binentries == h1.binentries))
+        self.assertTrue(np.all(h.bincontent == h1.bincontent))
+        self.assertTrue(np.all(h.squaredweights == h1.squaredweights))
+
+    def test_isub_operator_noe_check(self):
+        """Tests if the -= operator raises a ValueError, if the number of
+        entries of a bin would become negative, without altering any bin.
+
+        """
+        h1 = ndhist.ndhist((ndhist.axes.linear(0, 10, 1),))
+        h1.fill([0.5, 1.5], [1, 2])
+        h2 = h1.empty_like()
+        h2.fill([0.5, 2.5], [1, 3])
+
+        def _isub():
+            h1.__isub__(h2)
+        self.assertRaises(ValueError, _isub)
+        self.assertTrue(np.all(h1.binentries == np.array([1,1,0,0,0,0,0,0,0,0])))
+        self.assertTrue(np.all(h1.bincontent == np.array([1,2,0,0,0,0,0,0,0,0])))
+
+    def test_window(self):
+        """Tests if the total of a sliding-window histogram is the sum of the
+        slices within the window.
+
+        """
+        w = ndhist.window(ndhist.ndhist((ndhist.axes.linear(0, 10, 1),)), 3)
+        self.assertTrue(w.nslices == 3)
+
+        for tick in range(5):
+            w.fill([tick + 0.5], tick + 1)
+            w.advance()
+            w.fill([tick + 0.5, 9.5])
+
+        # The window holds the values filled after the third to last
+        # advance.
+        expected = w.total.empty_like()
+        for h in w.slices:
+            expected += h
+        self.assertTrue(np.all(w.total.binentries == expected.binentries))
+        self.assertTrue(np.all(w.total.bincontent == expected.bincontent))
+        self.assertTrue(np.all(w.total.binentries ==
+            np.array([0,0,1,2,2,0,0,0,0,3])))
+        self.assertTrue(np.all(w.total.bincontent ==
+            np.array([0,0,1,5,6,0,0,0,0,3])))
+
+        # The total is the running total itself, not a new histogram.
+        self.assertTrue(w.total is w.total)
+
+        # Values filled into the current slice are part of the total right
+        # away.
+        w.fill([5.5])
+        self.assertTrue(np.all(w.total.binentries ==
+            np.array([0,0,1,2,2,1,0,0,0,3])))
+
+        w.advance(3)
+        self.assertTrue(np.all(w.total.binentries == 0))
+        self.assertTrue(np.all(w.current.binentries == 0))
+
+if(__name__ == "__main__"):
+    unittest.main()